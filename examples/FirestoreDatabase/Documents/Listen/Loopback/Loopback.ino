@@ -0,0 +1,262 @@
+/**
+ * The example shows how to check the Listen channel (WebChannel) of Firestore::Documents, its session, the changes
+ * and the resume token after the session was created again, without the network and Firebase project.
+ *
+ * The LoopbackServer class below is the stand-in Firestore server that works as the network client (Client).
+ * It answers the session request with the X-HTTP-Session-Id header and the session id message, then sends the
+ * length-prefixed WebChannel messages of target changes and document changes to the back channel requests
+ * in the same way as the Firestore WebChannel wire protocol.
+ *
+ * The server closes the first session after the changes were read, the target is added again with the resume token
+ * of the first session to the second session.
+ *
+ * The results of the checks are printed to Serial, the same sketch can be used on any device.
+ *
+ * To listen to the Firestore documents, replace the LoopbackServer with the SSL client and use your project Id and authentication.
+ */
+
+#include <Arduino.h>
+#include <FirebaseClient.h>
+
+#define DOCUMENT_NAME "projects/loopback/databases/(default)/documents/users/alice"
+
+class LoopbackServer : public Client
+{
+public:
+    int connections = 0, requests = 0, failures = 0;
+
+    int connect(IPAddress ip, uint16_t port) override { return connect("", port); }
+
+    int connect(const char *host, uint16_t port) override
+    {
+        connections++;
+        conn = true;
+        request.remove(0, request.length());
+        out.remove(0, out.length());
+        out_pos = 0;
+        return 1;
+    }
+
+    size_t write(uint8_t b) override { return write(&b, 1); }
+
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        for (size_t i = 0; i < size; i++)
+            request += (char)buf[i];
+
+        // The request is completed when its header and Content-Length bytes of body were received.
+        int pos = request.indexOf("\r\n\r\n");
+        if (pos > -1)
+        {
+            String body = request.substring(pos + 4);
+            if ((int)body.length() >= contentLength(request.substring(0, pos)))
+            {
+                String line = request.substring(0, request.indexOf("\r\n"));
+                request.remove(0, request.length());
+                processRequest(line, body);
+            }
+        }
+        return size;
+    }
+
+    int available() override { return out.length() - out_pos; }
+
+    int read() override { return out_pos < out.length() ? (uint8_t)out[out_pos++] : -1; }
+
+    int read(uint8_t *buf, size_t size) override
+    {
+        size_t n = 0;
+        while (n < size && out_pos < out.length())
+            buf[n++] = out[out_pos++];
+        return n;
+    }
+
+    int peek() override { return out_pos < out.length() ? (uint8_t)out[out_pos] : -1; }
+
+    void flush() override {}
+
+    void stop() override { conn = false; }
+
+    uint8_t connected() override { return conn; }
+
+    operator bool() override { return conn; }
+
+private:
+    bool conn = false;
+    String request, out;
+    size_t out_pos = 0;
+
+    int contentLength(const String &header)
+    {
+        int pos = header.indexOf("Content-Length: ");
+        return pos > -1 ? atoi(header.c_str() + pos + 16) : 0;
+    }
+
+    // The value of query parameter in the request line e.g. GET /path?SID=xxx&AID=0 HTTP/1.1
+    String param(const String &line, const String &name)
+    {
+        int pos = line.indexOf("&" + name + "=");
+        if (pos == -1)
+            pos = line.indexOf("?" + name + "=");
+        if (pos == -1)
+            return "-";
+        pos += name.length() + 2;
+        int end = pos;
+        while (end < (int)line.length() && line[end] != '&' && line[end] != ' ')
+            end++;
+        return line.substring(pos, end);
+    }
+
+    void check(bool pass, const char *name)
+    {
+        if (!pass)
+        {
+            failures++;
+            Firebase.printf("request %d check failed: %s\n", requests, name);
+        }
+    }
+
+    void processRequest(const String &line, const String &body)
+    {
+        requests++;
+        check(line.indexOf("/google.firestore.v1.Firestore/Listen/channel?") > -1, "channel path");
+
+        if (line.startsWith("POST "))
+        {
+            // The session request adds the target, the resume token is sent when the session was created again.
+            bool first = requests == 1;
+            check(requests == 1 || requests == 4, "session order");
+            check(param(line, "SID") == "-" && param(line, "gsessionid") == "-", "no session params");
+            check(body.indexOf("req0___data__=") > -1 && body.indexOf("addTarget") > -1, "add target");
+            check(body.indexOf("users%2Falice") > -1 || body.indexOf("users/alice") > -1, "document");
+            check(first ? body.indexOf("resumeToken") == -1 : body.indexOf("token1") > -1, "resume token");
+            sendSession(first ? "gs1" : "gs2", first ? "sid1" : "sid2");
+            return;
+        }
+
+        // The back channel request of session.
+        bool first = requests < 4;
+        check(param(line, "SID") == (first ? "sid1" : "sid2"), "SID");
+        check(param(line, "gsessionid") == (first ? "gs1" : "gs2"), "gsessionid");
+        check(param(line, "RID") == "rpc" && param(line, "TYPE") == "xmlhttp", "back channel params");
+
+        std::vector<String> frames;
+        if (requests == 2)
+        {
+            check(param(line, "AID") == "0", "AID");
+            frames.push_back("[[1,[{\"targetChange\":{\"targetChangeType\":\"ADD\",\"targetIds\":[1]}}]]]");
+            frames.push_back("[[2,[{\"documentChange\":{\"document\":{\"name\":\"" DOCUMENT_NAME "\",\"fields\":{\"age\":{\"integerValue\":\"30\"}}},\"targetIds\":[1]}}]],"
+                             "[3,[{\"targetChange\":{\"targetChangeType\":\"CURRENT\",\"targetIds\":[1],\"resumeToken\":\"token1\"}}]]]");
+        }
+        else if (requests == 3)
+        {
+            // The last message id that was read is acknowledged, the session is closed.
+            check(param(line, "AID") == "3", "AID");
+            frames.push_back("[[4,[\"close\"]]]");
+        }
+        else if (requests == 5)
+        {
+            check(param(line, "AID") == "0", "AID");
+            frames.push_back("[[1,[{\"documentChange\":{\"document\":{\"name\":\"" DOCUMENT_NAME "\",\"fields\":{\"age\":{\"integerValue\":\"31\"}}},\"targetIds\":[1]}}]],"
+                             "[2,[{\"targetChange\":{\"targetChangeType\":\"CURRENT\",\"targetIds\":[1],\"resumeToken\":\"token2\"}}]]]");
+        }
+        else
+            frames.push_back("[[" + param(line, "AID") + ",[\"noop\"]]]");
+
+        // The WebChannel messages are length-prefixed, the response is chunked.
+        out += "HTTP/1.1 200 OK\r\nContent-Type: application/javascript; charset=utf-8\r\nConnection: keep-alive\r\nTransfer-Encoding: chunked\r\n\r\n";
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            String frame = String(frames[i].length()) + "\n" + frames[i];
+            out += String(frame.length(), HEX) + "\r\n" + frame + "\r\n";
+        }
+        out += "0\r\n\r\n";
+    }
+
+    void sendSession(const String &gsessionid, const String &sid)
+    {
+        String frame = "[[0,[\"c\",\"" + sid + "\",\"\",8,14,30000]]]";
+        frame = String(frame.length()) + "\n" + frame;
+        out += "HTTP/1.1 200 OK\r\nContent-Type: application/javascript; charset=utf-8\r\nConnection: keep-alive\r\nX-HTTP-Session-Id: " + gsessionid + "\r\nContent-Length: " + String(frame.length()) + "\r\n\r\n" + frame;
+    }
+};
+
+LoopbackServer server;
+
+// The loopback server does not need the network, the network is always connected.
+void netConnect() {}
+void netStatus(bool &status) { status = true; }
+
+GenericNetwork network(netConnect, netStatus);
+AsyncClientClass aClient(server, getNetwork(network));
+
+FirebaseApp app;
+NoAuth noAuth;
+Firestore::Documents Docs;
+Firestore::DocumentListener listener;
+
+int responses = 0, errors = 0;
+bool listening = false, printed = false;
+
+// The expected ListenResponse objects of both sessions in order.
+const char *expected[] = {
+    "{\"targetChange\":{\"targetChangeType\":\"ADD\",\"targetIds\":[1]}}",
+    "{\"documentChange\":{\"document\":{\"name\":\"" DOCUMENT_NAME "\",\"fields\":{\"age\":{\"integerValue\":\"30\"}}},\"targetIds\":[1]}}",
+    "{\"targetChange\":{\"targetChangeType\":\"CURRENT\",\"targetIds\":[1],\"resumeToken\":\"token1\"}}",
+    "{\"documentChange\":{\"document\":{\"name\":\"" DOCUMENT_NAME "\",\"fields\":{\"age\":{\"integerValue\":\"31\"}}},\"targetIds\":[1]}}",
+    "{\"targetChange\":{\"targetChangeType\":\"CURRENT\",\"targetIds\":[1],\"resumeToken\":\"token2\"}}"};
+
+void processData(AsyncResult &aResult)
+{
+    if (aResult.isError())
+    {
+        errors++;
+        Firebase.printf("Error task: %s, msg: %s, code: %d\n", aResult.uid().c_str(), aResult.error().message().c_str(), aResult.error().code());
+    }
+
+    if (aResult.available())
+    {
+        bool match = responses < 5 && strcmp(aResult.c_str(), expected[responses]) == 0;
+        if (!match)
+            errors++;
+        responses++;
+        Firebase.printf("response: %s, %s\n", aResult.c_str(), match ? "match" : "mismatch");
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    Firebase.printf("Firebase Client v%s\n", FIREBASE_CLIENT_VERSION);
+
+    initializeApp(aClient, app, getAuth(noAuth));
+
+    app.getApp<Firestore::Documents>(Docs);
+
+    listener.addDocument("users/alice");
+}
+
+void loop()
+{
+    app.loop();
+
+    Docs.loop();
+
+    if (!app.ready())
+        return;
+
+    if (!listening)
+    {
+        listening = true;
+        Docs.listen(aClient, Firestore::Parent("loopback"), listener, processData, "listenTask");
+    }
+    else if (!printed && responses == 5)
+    {
+        printed = true;
+        listener.stop();
+        // Two sessions, three back channel requests, five responses and the resume token of the second session.
+        bool pass = errors == 0 && server.failures == 0 && server.requests == 5 && listener.resumeToken() == "token2";
+        Firebase.printf("responses: %d, errors: %d, requests: %d, failures: %d, token: %s, %s\n", responses, errors, server.requests, server.failures, listener.resumeToken().c_str(), pass ? "PASS" : "FAIL");
+    }
+}
@@ -0,0 +1,296 @@
+/**
+ * The example shows how to check the listen, write and acknowledgement of DatabaseSocket over one connection
+ * without the network and Firebase project.
+ *
+ * The LoopbackServer class below is the stand-in Realtime database server that works as the network client (Client).
+ * It answers the WebSocket upgrade request and the handshake, keeps the written values in memory, acknowledges
+ * the writes and sends the data events of the listening paths in the same way as the Firebase WebSocket wire protocol (v5).
+ *
+ * The results of the checks are printed to Serial, the same sketch can be used on any device.
+ *
+ * To use DatabaseSocket with Firebase, replace the LoopbackServer with the SSL client and set your database URL.
+ */
+
+#include <Arduino.h>
+#include <FirebaseClient.h>
+
+class LoopbackServer : public Client
+{
+public:
+    int connections = 0;
+
+    int connect(IPAddress ip, uint16_t port) override { return connect("", port); }
+
+    int connect(const char *host, uint16_t port) override
+    {
+        connections++;
+        conn = true;
+        upgraded = false;
+        request.remove(0, request.length());
+        out.remove(0, out.length());
+        rx_len = 0;
+        return 1;
+    }
+
+    size_t write(uint8_t b) override { return write(&b, 1); }
+
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            if (!upgraded)
+                readRequest(buf[i]);
+            else
+                readFrame(buf[i]);
+        }
+        return size;
+    }
+
+    int available() override { return out.length() - out_pos; }
+
+    int read() override { return out_pos < out.length() ? (uint8_t)out[out_pos++] : -1; }
+
+    int read(uint8_t *buf, size_t size) override
+    {
+        size_t n = 0;
+        while (n < size && out_pos < out.length())
+            buf[n++] = out[out_pos++];
+        return n;
+    }
+
+    int peek() override { return out_pos < out.length() ? (uint8_t)out[out_pos] : -1; }
+
+    void flush() override {}
+
+    void stop() override { conn = false; }
+
+    uint8_t connected() override { return conn; }
+
+    operator bool() override { return conn; }
+
+private:
+    bool conn = false, upgraded = false;
+    String request, out, listen_path;
+    size_t out_pos = 0;
+
+    // The values that were written, the path and its JSON value.
+    String paths[10], values[10];
+    int value_count = 0;
+
+    // The received frame header and payload.
+    uint8_t rx_hdr[8];
+    size_t rx_len = 0, payload_len = 0;
+    String payload;
+
+    void readRequest(uint8_t c)
+    {
+        request += (char)c;
+        if (request.endsWith("\r\n\r\n"))
+        {
+            upgraded = true;
+            send("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\r\n", false);
+            send("{\"t\":\"c\",\"d\":{\"t\":\"h\",\"d\":{\"ts\":1,\"v\":\"5\",\"h\":\"loopback\",\"s\":\"session\"}}}", true);
+        }
+    }
+
+    // Read the masked text frame of client, the payload is shorter than 65536 bytes.
+    void readFrame(uint8_t b)
+    {
+        if (rx_len < 2 || (rx_len < 4 && (rx_hdr[1] & 0x7f) == 126) || rx_len < hdrLen())
+        {
+            rx_hdr[rx_len++] = b;
+            if (rx_len == hdrLen())
+            {
+                payload_len = (rx_hdr[1] & 0x7f) == 126 ? (rx_hdr[2] << 8) | rx_hdr[3] : rx_hdr[1] & 0x7f;
+                payload.remove(0, payload.length());
+                if (payload_len == 0)
+                    rx_len = 0;
+            }
+            return;
+        }
+
+        payload += (char)(b ^ rx_hdr[hdrLen() - 4 + payload.length() % 4]);
+        if (payload.length() == payload_len)
+        {
+            rx_len = 0;
+            processMessage(payload);
+        }
+    }
+
+    size_t hdrLen() { return rx_len >= 2 && (rx_hdr[1] & 0x7f) == 126 ? 8 : 6; }
+
+    void processMessage(const String &msg)
+    {
+        JsonReader reader;
+        if (!reader.parse(msg) || reader.get("/t") != "\"d\"")
+            return;
+
+        int id = reader.to<int>("/d/r");
+        String action = reader.get("/d/a"), path = reader.get("/d/b/p");
+        path = path.substring(1, path.length() - 1);
+
+        if (action == "\"q\"") // listen
+        {
+            listen_path = path;
+            sendData(path, valueOf(path));
+        }
+        else if (action == "\"p\"" || action == "\"m\"") // put and merge
+        {
+            String data = reader.get("/d/b/d");
+            if (action == "\"p\"")
+                setValue(path, data);
+            else
+            {
+                for (size_t i = 0; i < reader.size("/d/b/d"); i++)
+                {
+                    String key = reader.key("/d/b/d", i);
+                    setValue(path + "/" + key, reader.get("/d/b/d/" + key));
+                }
+            }
+
+            if (listen_path.length() && path.startsWith(listen_path))
+                send(String("{\"t\":\"d\",\"d\":{\"a\":\"") + (action == "\"p\"" ? "d" : "m") + "\",\"b\":{\"p\":\"" + path + "\",\"d\":" + data + "}}}", true);
+        }
+
+        send("{\"t\":\"d\",\"d\":{\"r\":" + String(id) + ",\"b\":{\"s\":\"ok\",\"d\":\"\"}}}", true);
+    }
+
+    String valueOf(const String &path)
+    {
+        for (int i = 0; i < value_count; i++)
+        {
+            if (paths[i] == path)
+                return values[i];
+        }
+        return "null";
+    }
+
+    void setValue(const String &path, const String &value)
+    {
+        for (int i = 0; i < value_count; i++)
+        {
+            if (paths[i] == path)
+            {
+                values[i] = value;
+                return;
+            }
+        }
+        if (value_count < 10)
+        {
+            paths[value_count] = path;
+            values[value_count++] = value;
+        }
+    }
+
+    void sendData(const String &path, const String &data) { send("{\"t\":\"d\",\"d\":{\"a\":\"d\",\"b\":{\"p\":\"" + path + "\",\"d\":" + data + "}}}", true); }
+
+    // Send the HTTP response or the unmasked text frame of server.
+    void send(const String &data, bool frame)
+    {
+        if (out_pos == out.length())
+        {
+            out.remove(0, out.length());
+            out_pos = 0;
+        }
+
+        if (frame)
+        {
+            out += (char)0x81;
+            if (data.length() < 126)
+                out += (char)data.length();
+            else
+            {
+                out += (char)126;
+                out += (char)(data.length() >> 8);
+                out += (char)(data.length() & 0xff);
+            }
+        }
+        out += data;
+    }
+};
+
+LoopbackServer server;
+
+DefaultNetwork network;
+AsyncClientClass aClient(server, getNetwork(network));
+
+FirebaseApp app;
+NoAuth noAuth;
+DatabaseSocket socket("ws://loopback:9000?ns=loopback");
+
+int events = 0, acks = 0, errors = 0;
+bool ledSet = false, countUpdated = false, printed = false;
+
+void processData(AsyncResult &aResult)
+{
+    if (aResult.isError())
+    {
+        errors++;
+        Firebase.printf("Error task: %s, msg: %s, code: %d\n", aResult.uid().c_str(), aResult.error().message().c_str(), aResult.error().code());
+    }
+
+    if (aResult.available())
+    {
+        RealtimeDatabaseResult &RTDB = aResult.to<RealtimeDatabaseResult>();
+        events++;
+        Firebase.printf("event: %s, path: %s, data: %s\n", RTDB.event().c_str(), RTDB.dataPath().c_str(), RTDB.to<const char *>());
+    }
+}
+
+// The write callback is called once when the write was acknowledged or rejected.
+void processAck(AsyncResult &aResult)
+{
+    if (aResult.isError())
+    {
+        errors++;
+        Firebase.printf("Error task: %s, msg: %s, code: %d\n", aResult.uid().c_str(), aResult.error().message().c_str(), aResult.error().code());
+    }
+    else
+    {
+        acks++;
+        Firebase.printf("ack task: %s\n", aResult.uid().c_str());
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    Firebase.printf("Firebase Client v%s\n", FIREBASE_CLIENT_VERSION);
+
+    initializeApp(aClient, app, getAuth(noAuth));
+
+    socket.setClient(server);
+
+    app.getApp<DatabaseSocket>(socket);
+
+    socket.listen("/loopback", processData, "listenTask");
+}
+
+void loop()
+{
+    app.loop();
+
+    socket.loop();
+
+    if (!socket.ready())
+        return;
+
+    if (!ledSet)
+    {
+        ledSet = true;
+        socket.set<bool>("/loopback/led", true, processAck, "setTask");
+    }
+    else if (!countUpdated && acks == 1)
+    {
+        countUpdated = true;
+        socket.update<object_t>("/loopback", object_t("{\"count\":1}"), processAck, "updateTask");
+    }
+    else if (!printed && acks == 2)
+    {
+        printed = true;
+        // The initial data event, the put event and the patch event are received with two acknowledgements over one connection.
+        bool pass = events == 3 && errors == 0 && server.connections == 1;
+        Firebase.printf("events: %d, acks: %d, errors: %d, connections: %d, %s\n", events, acks, errors, server.connections, pass ? "PASS" : "FAIL");
+    }
+}
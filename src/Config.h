@@ -121,6 +121,27 @@
  * 🏷️ For maximum async queue limit setting for an async client
  * #define FIREBASE_ASYNC_QUEUE_LIMIT 10
  * 
+ * 🏷️ For maximum number of silent write requests that are sent before their responses were read (HTTP pipelining)
+ * #define FIREBASE_PIPELINE_DEPTH 4
+ * 
+ * 🏷️ For maximum number of writes of Realtime database transaction
+ * #define FIREBASE_TRANSACTION_MAX_ATTEMPTS 10
+ * 
+ * 🏷️ For milliseconds to wait before retrying the write of Realtime database transaction (doubled for every retry)
+ * #define FIREBASE_TRANSACTION_BACKOFF_MS 100
+ * 
+ * 🏷️ For maximum size of Realtime database WebSocket message frame
+ * #define FIREBASE_SOCKET_FRAME_SIZE 16384
+ * 
+ * 🏷️ For milliseconds of idle time before the Realtime database WebSocket keep-alive message was sent
+ * #define FIREBASE_SOCKET_KEEP_ALIVE_MS 45000
+ * 
+ * 🏷️ For maximum milliseconds to wait before reconnecting the Realtime database WebSocket (doubled for every retry)
+ * #define FIREBASE_SOCKET_MAX_RETRY_MS 30000
+ * 
+ * 🏷️ For the number of decimal places of float and double members of the struct that was bound with FIREBASE_JSON_BINDING
+ * #define FIREBASE_JSON_BINDING_DECIMALS 6
+ * 
  * 🏷️ For Firebase.printf debug port.
  * #define FIREBASE_PRINTF_PORT Serial
  * 
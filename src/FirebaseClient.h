@@ -36,6 +36,12 @@
 #if __has_include("database/RealtimeDatabase.h")
 #include "database/RealtimeDatabase.h"
 #endif
+#if __has_include("database/DatabaseRouter.h")
+#include "database/DatabaseRouter.h"
+#endif
+#if __has_include("database/DatabaseSocket.h")
+#include "database/DatabaseSocket.h"
+#endif
 #endif
 
 #if defined(ENABLE_FIRESTORE)
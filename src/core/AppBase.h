@@ -37,6 +37,10 @@ public:
 protected:
     void setResultUID(AsyncResult *aResult, const String &uid) { aResult->val[ares_ns::res_uid] = uid; }
 
+    void setResultPayload(AsyncResult *aResult, const String &payload) { aResult->setPayload(payload); }
+
+    const String &getResultSessionId(AsyncResult *aResult) { return aResult->val[ares_ns::res_session_id]; }
+
     void setRVec(AsyncResult *aResult, uint32_t addr) { aResult->rvec_addr = addr; }
 
     std::vector<uint32_t> &getRVec(AsyncClientClass *aClient) { return aClient->rVec; }
@@ -66,6 +70,8 @@ protected:
 
     void addRemoveClientVecBase(AsyncClientClass *aClient, uint32_t cvec_addr, bool add) { aClient->addRemoveClientVec(cvec_addr, add); }
 
+    void setContentTypeBase(AsyncClientClass *aClient, async_data_item_t *sData, const String &type) { aClient->setContentType(sData, type); }
+
     void setContentLengthBase(AsyncClientClass *aClient, async_data_item_t *sData, size_t len) { aClient->setContentLength(sData, len); }
 
     void handleRemoveBase(AsyncClientClass *aClient) { aClient->handleRemove(); }
@@ -74,6 +80,12 @@ protected:
 
     size_t slotCountBase(AsyncClientClass *aClient) { return aClient->sVec.size(); }
 
+    bool slotExistedBase(AsyncClientClass *aClient, uint32_t slot_addr)
+    {
+        List vec;
+        return slot_addr && vec.existed(aClient->sVec, slot_addr);
+    }
+
     void setLastErrorBase(AsyncResult *aResult, int code, const String &message)
     {
         if (aResult)
@@ -91,7 +91,15 @@ public:
     bool download = false;
     bool upload_progress_enabled = false;
     bool upload = false;
+    // The async write that its response payload is muted and its result is returned only when error.
+    bool silent = false;
+    // The elements of the top level JSON array in the response payload are returned one by one while reading.
+    bool array_stream = false;
+    // The response payload of the rejected write (HTTP 412) is kept in the result e.g. the current data for the compare-and-set transaction.
+    bool conflict_payload = false;
     uint32_t auth_ts = 0;
+    // The millis when the request was created.
+    unsigned long request_ms = 0;
     uint32_t addr = 0;
     AsyncResult aResult;
     AsyncResult *refResult = nullptr;
@@ -131,6 +139,10 @@ public:
         async = false;
         sse = false;
         path_not_existed = false;
+        silent = false;
+        array_stream = false;
+        conflict_payload = false;
+        request_ms = 0;
         cb = NULL;
         err_timer.reset();
     }
@@ -176,7 +188,7 @@ private:
     app_debug_t app_debug;
     app_event_t app_event;
     FirebaseError lastErr;
-    String header, reqEtag, resETag, sse_events_filter;
+    String header, reqEtag, resETag;
     AsyncResult *refResult = nullptr;
     AsyncResult aResult;
     int netErrState = 0;
@@ -184,6 +196,7 @@ private:
     uint32_t cvec_addr = 0;
     uint32_t result_addr = 0;
     uint32_t sync_send_timeout_sec = 0, sync_read_timeout_sec = 0, session_timeout_sec = 0;
+    uint32_t request_count = 0, error_count = 0, latency_ms = 0;
     Timer session_timer;
     Client *client = nullptr;
     bool client_changed = false, network_changed = false;
@@ -196,6 +209,14 @@ private:
     bool sse = false;
     String host;
     uint16_t port;
+    // The dedicated SSE mode (HTTP Streaming) connection.
+    // Its states are swapped with the above client, host, port and sse while the SSE task is processing.
+    Client *sse_client = nullptr;
+    String sse_host;
+    uint16_t sse_port = 0;
+    bool sse_conn_sse = false;
+    bool sse_conn_selected = false;
+    bool sse_conn_restart = false;
     std::vector<uint32_t> sVec;
     Memory mem;
     Base64Util b64ut;
@@ -232,6 +253,35 @@ private:
         return true;
     }
 
+    void swapConnection()
+    {
+        Client *c = client;
+        client = sse_client;
+        sse_client = c;
+
+        String h = host;
+        host = sse_host;
+        sse_host = h;
+
+        uint16_t p = port;
+        port = sse_port;
+        sse_port = p;
+
+        bool s = sse;
+        sse = sse_conn_sse;
+        sse_conn_sse = s;
+
+        sse_conn_selected = !sse_conn_selected;
+    }
+
+    // Select the dedicated SSE connection for SSE task or the primary connection for other tasks.
+    void selectConnection(async_data_item_t *sData)
+    {
+        bool use_sse_conn = sData && sData->sse && !sData->auth_used && (sse_conn_selected ? client : sse_client) && client_type == async_request_handler_t::tcp_client_type_sync;
+        if (use_sse_conn != sse_conn_selected)
+            swapConnection();
+    }
+
     void newCon(async_data_item_t *sData, const char *host, uint16_t port)
     {
 
@@ -792,11 +842,12 @@ private:
         }
     }
 
-    int readLine(async_data_item_t *sData, String &buf)
+    // Read the line, up to maxLen bytes when maxLen > -1.
+    int readLine(async_data_item_t *sData, String &buf, int maxLen = -1)
     {
         int p = 0;
 
-        while (sData->response.tcpAvailable(client_type, client, async_tcp_config))
+        while ((maxLen < 0 || p < maxLen) && sData->response.tcpAvailable(client_type, client, async_tcp_config))
         {
             int res = sData->response.tcpRead(client_type, client, async_tcp_config);
             if (res > -1)
@@ -848,10 +899,17 @@ private:
                 // read payload
                 else if (sData->response.flags.payload_remaining || sData->response.flags.sse)
                 {
+#if defined(ENABLE_DATABASE)
+                    if (sData->response.flags.sse && !sData->auth_used)
+                    {
+                        readEvent(sData);
+                        return true;
+                    }
+#endif
                     if (!readPayload(sData))
                         return false;
 
-                    if (sData->response.flags.sse || !sData->response.flags.payload_remaining)
+                    if (!sData->response.flags.payload_remaining)
                     {
                         if (!sData->auth_used)
                         {
@@ -864,40 +922,6 @@ private:
 
                             if (sData->request.method == async_request_handler_t::http_post)
                                 parseNodeName(&sData->aResult.rtdbResult);
-
-                            // data available from sse event
-                            if (sData->response.flags.sse && sData->response.val[res_hndlr_ns::payload].length())
-                            {
-                                // order of checking: event, data, newline
-                                if (sData->response.val[res_hndlr_ns::payload].indexOf("event: ") > -1 && sData->response.val[res_hndlr_ns::payload].indexOf("data: ") > -1 && sData->response.val[res_hndlr_ns::payload].indexOf("\n") > -1)
-                                {
-
-                                    parseSSE(&sData->aResult.rtdbResult);
-
-                                    // Event filtering.
-                                    String event = sData->aResult.rtdbResult.event();
-                                    if (sse_events_filter.length() == 0 ||
-                                        (sData->response.flags.http_response && sse_events_filter.indexOf("get") > -1 && event.indexOf("put") > -1) ||
-                                        (!sData->response.flags.http_response && sse_events_filter.indexOf("put") > -1 && event.indexOf("put") > -1) ||
-                                        (sse_events_filter.indexOf("patch") > -1 && event.indexOf("patch") > -1) ||
-                                        (sse_events_filter.indexOf("keep-alive") > -1 && event.indexOf("keep-alive") > -1) ||
-                                        (sse_events_filter.indexOf("cancel") > -1 && event.indexOf("cancel") > -1) ||
-                                        (sse_events_filter.indexOf("auth_revoked") > -1 && event.indexOf("auth_revoked") > -1))
-                                    {
-                                        // save payload to slot result
-                                        sData->aResult.setPayload(sData->response.val[res_hndlr_ns::payload]);
-                                        clear(sData->response.val[res_hndlr_ns::payload]);
-                                        sData->response.flags.payload_available = true;
-                                        returnResult(sData, true);
-                                    }
-                                    else
-                                    {
-                                        clear(sData->response.val[res_hndlr_ns::payload]);
-                                    }
-
-                                    sData->response.flags.http_response = false;
-                                }
-                            }
 #endif
                         }
                     }
@@ -908,6 +932,141 @@ private:
         return true;
     }
 
+#if defined(ENABLE_DATABASE)
+    // Read the SSE mode (HTTP Streaming) data until an event is available.
+    void readEvent(async_data_item_t *sData)
+    {
+        if (!sData->response.flags.payload_remaining)
+            return;
+
+        sData->response.feedTimer(!sData->async && sync_read_timeout_sec > 0 ? sync_read_timeout_sec : -1);
+
+        if (sData->response.flags.chunks)
+        {
+            // The decoded chunk can contain more than one event.
+            String chunk;
+            if (decodeChunks(sData, client, &chunk) == -1)
+                sData->response.flags.payload_remaining = false;
+
+            for (size_t i = 0; i < chunk.length(); i++)
+                parseEvent(sData, chunk[i]);
+            return;
+        }
+
+        // The queued events are read until the queue is blocked.
+        while (!sData->response.sse_queue.blocked() && sData->response.tcpAvailable(client_type, client, async_tcp_config))
+        {
+            int res = sData->response.tcpRead(client_type, client, async_tcp_config);
+            if (res < 0)
+                break;
+
+            sData->response.payloadRead++;
+
+            // One event per read.
+            if (parseEvent(sData, (char)res))
+                break;
+        }
+    }
+
+    // Returns true when the event that passes the filter was returned.
+    bool parseEvent(async_data_item_t *sData, char c)
+    {
+        SSEParser::parse_result res = sData->response.sse_parser.parse(c, sData->response.val[res_hndlr_ns::payload], sData->response.flags.http_response);
+
+        if (res == SSEParser::parse_result_continue)
+            return false;
+
+        sData->response.flags.http_response = false;
+
+        // The filtered out and queued events also keep the stream alive.
+        feedSSE(&sData->aResult.rtdbResult, sData->response.sse_parser.event().type);
+
+        if (res == SSEParser::parse_result_dropped)
+            return false;
+
+        if (sData->response.sse_coalescer.push(sData->response.val[res_hndlr_ns::payload], sData->response.sse_parser.event()))
+        {
+            clear(sData->response.val[res_hndlr_ns::payload]);
+            return false;
+        }
+
+        if (sData->response.sse_queue.enabled())
+        {
+            sData->response.sse_queue.push(sData->response.val[res_hndlr_ns::payload], sData->response.sse_parser.event());
+            clear(sData->response.val[res_hndlr_ns::payload]);
+            return false;
+        }
+
+        // save payload to slot result
+        sData->aResult.setPayload(sData->response.val[res_hndlr_ns::payload]);
+        clear(sData->response.val[res_hndlr_ns::payload]);
+        returnEvent(sData, sData->response.sse_parser.event());
+        return true;
+    }
+
+    // Return the oldest queued event, one event per process.
+    void returnQueuedEvent(async_data_item_t *sData)
+    {
+        // The merged events are queued when the events queue was enabled.
+        SSECoalescer::item_t *merged = sData->response.sse_coalescer.front();
+        while (merged && sData->response.sse_queue.enabled() && !sData->response.sse_queue.full())
+        {
+            sData->response.sse_queue.push(merged->payload, merged->event);
+            sData->response.sse_coalescer.pop();
+            merged = sData->response.sse_coalescer.front();
+        }
+
+        if (merged && !sData->response.sse_queue.enabled())
+        {
+            sData->aResult.setPayload(merged->payload);
+            sse_event_t event = merged->event;
+            sData->response.sse_coalescer.pop();
+            returnEvent(sData, event);
+            return;
+        }
+
+        SSEQueue::item_t *item = sData->response.sse_queue.front();
+        if (!item)
+            return;
+
+        sData->aResult.setPayload(item->payload);
+        sse_event_t event = item->event;
+        sData->response.sse_queue.pop();
+        returnEvent(sData, event);
+    }
+
+    void returnEvent(async_data_item_t *sData, const sse_event_t &event)
+    {
+        setSSE(&sData->aResult.rtdbResult, event);
+        setSSEQueueStatus(&sData->aResult.rtdbResult, sData->response.sse_queue.size() + sData->response.sse_coalescer.size(), sData->response.sse_queue.lost(),
+                          sData->response.sse_queue.coalesced() + sData->response.sse_coalescer.coalesced());
+        sData->response.flags.payload_available = true;
+        returnResult(sData, true);
+    }
+#endif
+
+#if defined(ENABLE_FIRESTORE)
+    bool isArrayStream(async_data_item_t *sData) { return sData->array_stream && !sData->auth_used && sData->response.httpCode == FIREBASE_ERROR_HTTP_CODE_OK; }
+
+    // Return the completed elements of the top level JSON array in the read data.
+    void parseArray(async_data_item_t *sData, const String &data)
+    {
+        for (size_t i = 0; i < data.length(); i++)
+        {
+            if (sData->response.array_parser.parse(data[i], sData->response.val[res_hndlr_ns::payload]) != JsonStreamParser::parse_result_element)
+                continue;
+
+            sData->aResult.setPayload(sData->response.val[res_hndlr_ns::payload]);
+            clear(sData->response.val[res_hndlr_ns::payload]);
+            returnResult(sData, true);
+
+            // The element was taken, the result of completed response has no payload.
+            clearAppData(sData->aResult.app_data);
+            clear(sData->aResult.val[ares_ns::data_payload]);
+        }
+    }
+#endif
+
     int getStatusCode(const String &header)
     {
         String out;
@@ -961,6 +1120,12 @@ private:
                 resETag = sData->response.val[res_hndlr_ns::etag];
                 sData->aResult.val[ares_ns::res_etag] = sData->response.val[res_hndlr_ns::etag];
                 sData->aResult.val[ares_ns::data_path] = sData->request.val[req_hndlr_ns::path];
+#if defined(ENABLE_FIRESTORE)
+                // The session id of Firestore Listen channel (WebChannel).
+                clear(sData->aResult.val[ares_ns::res_session_id]);
+                if (sData->array_stream)
+                    parseRespHeader(sData, sData->response.val[res_hndlr_ns::header], sData->aResult.val[ares_ns::res_session_id], "X-HTTP-Session-Id");
+#endif
 #if defined(ENABLE_DATABASE)
                 setNullETagOption(&sData->aResult.rtdbResult, sData->response.val[res_hndlr_ns::etag].indexOf("null_etag") > -1);
 #endif
@@ -1062,22 +1227,25 @@ private:
             {
                 String chunk;
                 int read = readLine(sData, chunk);
-                if (read && chunk[0] != '\r')
-                    *out += chunk;
                 if (read)
                 {
+                    // The CRLF that follows the chunk data is not the part of entity-body.
+                    int avail = sData->response.chunkInfo.chunkSize - sData->response.chunkInfo.dataLen;
+                    if (avail > 0)
+                        *out += read > avail ? chunk.substring(0, avail) : chunk;
+
                     sData->response.chunkInfo.dataLen += read;
                     sData->response.payloadRead += read;
                     // chunk may contain trailing
                     if (sData->response.chunkInfo.dataLen - 2 >= sData->response.chunkInfo.chunkSize)
                     {
+                        // The last chunk and its CRLF were read, the next data on this connection belongs to the next response.
+                        if (sData->response.chunkInfo.chunkSize == 0)
+                            res = -1;
                         sData->response.chunkInfo.dataLen = sData->response.chunkInfo.chunkSize;
                         sData->response.chunkInfo.phase = async_response_handler_t::READ_CHUNK_SIZE;
                     }
                 }
-                // if all chunks read, returns -1
-                else if (sData->response.chunkInfo.dataLen == sData->response.chunkInfo.chunkSize)
-                    res = -1;
             }
         }
 
@@ -1098,8 +1266,17 @@ private:
 
                 if (sData->response.flags.chunks)
                 {
-                    if (decodeChunks(sData, client, &sData->response.val[res_hndlr_ns::payload]) == -1)
+                    String chunk, *out = &sData->response.val[res_hndlr_ns::payload];
+#if defined(ENABLE_FIRESTORE)
+                    if (isArrayStream(sData))
+                        out = &chunk;
+#endif
+                    if (decodeChunks(sData, client, out) == -1)
                         sData->response.flags.payload_remaining = false;
+#if defined(ENABLE_FIRESTORE)
+                    if (out == &chunk)
+                        parseArray(sData, chunk);
+#endif
                 }
                 else
                 {
@@ -1246,8 +1423,16 @@ private:
                             returnResult(sData, false);
                         }
                     }
+#if defined(ENABLE_FIRESTORE)
+                    else if (isArrayStream(sData))
+                    {
+                        String line;
+                        sData->response.payloadRead += readLine(sData, line, payloadRemaining(sData));
+                        parseArray(sData, line);
+                    }
+#endif
                     else
-                        sData->response.payloadRead += readLine(sData, sData->response.val[res_hndlr_ns::payload]);
+                        sData->response.payloadRead += readLine(sData, sData->response.val[res_hndlr_ns::payload], payloadRemaining(sData));
                 }
             }
         }
@@ -1256,19 +1441,9 @@ private:
         if (buf)
             mem.release(&buf);
 
-        if (sData->response.payloadLen > 0 && sData->response.payloadRead >= sData->response.payloadLen && sData->response.tcpAvailable(client_type, client, async_tcp_config) == 0)
+        // The response is framed by its Content-Length or its last chunk, the data that follows it is the next (pipelined) response.
+        if (sData->response.payloadLen > 0 && (sData->response.flags.chunks ? !sData->response.flags.payload_remaining : sData->response.payloadRead >= sData->response.payloadLen))
         {
-
-            // Async payload and header data collision workaround from session reusage.
-            if (!sData->response.flags.chunks && sData->response.payloadRead > sData->response.payloadLen)
-            {
-                sData->response.val[res_hndlr_ns::header] = sData->response.val[res_hndlr_ns::payload].substring(sData->response.payloadRead - sData->response.payloadLen);
-                sData->response.val[res_hndlr_ns::payload].remove(0, sData->response.payloadLen);
-                sData->return_type = function_return_type_continue;
-                sData->state = async_state_read_response;
-                sData->response.flags.header_remaining = true;
-            }
-
             if (sData->upload)
             {
                 URLUtil uut;
@@ -1281,6 +1456,8 @@ private:
             // In case HTTP error.
             if (sData->response.httpCode >= FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST)
             {
+                if (sData->conflict_payload && sData->response.httpCode == FIREBASE_ERROR_HTTP_CODE_PRECONDITION_FAILED)
+                    sData->aResult.setPayload(sData->response.val[res_hndlr_ns::payload]);
                 setAsyncError(sData, sData->state, sData->response.httpCode, !sData->sse, true);
                 sData->return_type = function_return_type_failure;
                 returnResult(sData, false);
@@ -1303,6 +1480,14 @@ private:
         return sData->error.code == 0;
     }
 
+    // The number of payload bytes to read from Content-Length or -1 when the payload length is unknown.
+    int payloadRemaining(async_data_item_t *sData)
+    {
+        if (sData->response.payloadLen == 0)
+            return -1;
+        return sData->response.payloadRead < sData->response.payloadLen ? sData->response.payloadLen - sData->response.payloadRead : 0;
+    }
+
     // non-block memory buffer for collecting the multiple of 4 data prepared for base64 decoding
     uint8_t *asyncBase64Buffer(async_data_item_t *sData, Memory &mem, int &toRead, int &read)
     {
@@ -1352,7 +1537,10 @@ private:
     void reset(async_data_item_t *sData, bool disconnect)
     {
         if (disconnect)
+        {
             stop(sData);
+            resetPipelined(sData);
+        }
 
         sData->response.httpCode = 0;
         sData->error.code = 0;
@@ -1942,6 +2130,71 @@ private:
         return false;
     }
 
+    // Send the requests of the next silent writes while waiting for the response of the first silent write (HTTP pipelining).
+    // Their responses are read in order when their slots become the first slot.
+    void sendPipelined(async_data_item_t *first)
+    {
+        if (!first->silent || first->state != async_state_read_response || sse || client_type != async_request_handler_t::tcp_client_type_sync || !client || !client->connected())
+            return;
+
+        // The connection that will be closed by session timeout can not be used.
+        if (session_timeout_sec >= FIREBASE_SESSION_TIMEOUT_SEC && session_timer.remaining() == 0)
+            return;
+
+        size_t depth = 1;
+        for (size_t slot = 1; slot < slotCount() && depth < FIREBASE_PIPELINE_DEPTH; slot++)
+        {
+            async_data_item_t *sData = getData(slot);
+            if (!sData || !sData->silent || !sData->async || sData->sse || sData->auth_used || sData->upload || sData->download || sData->to_remove)
+                break;
+
+            if (sData->state == async_state_read_response)
+            {
+                depth++;
+                continue;
+            }
+
+            if (sData->state != async_state_undefined || strcmp(getHost(sData, true).c_str(), host.c_str()) != 0 || sData->request.port != port)
+                break;
+
+            sData->response.clear();
+            sData->request.feedTimer(-1);
+            sData->return_type = send(sData);
+            while (sData->return_type != function_return_type_failure && (sData->state == async_state_send_header || sData->state == async_state_send_payload))
+                sData->return_type = send(sData);
+
+            if (sData->state != async_state_read_response)
+                break;
+
+            sData->response.feedTimer(-1);
+            depth++;
+        }
+    }
+
+    // The pipelined requests that were sent on the closed connection will not get their responses.
+    // The idempotent requests will be sent again on the next connection and the others are failed.
+    void resetPipelined(async_data_item_t *sData)
+    {
+        if (!sData || sData->sse)
+            return;
+
+        for (size_t slot = 0; slot < slotCount(); slot++)
+        {
+            async_data_item_t *pData = getData(slot);
+            if (!pData || pData == sData || !pData->silent || pData->sse || pData->to_remove || pData->state != async_state_read_response)
+                continue;
+
+            if (pData->request.method == async_request_handler_t::http_post)
+            {
+                // In case TCP (network) disconnected error.
+                setAsyncError(pData, pData->state, FIREBASE_ERROR_TCP_DISCONNECTED, true, false);
+                returnResult(pData, false);
+            }
+            else
+                reset(pData, false);
+        }
+    }
+
     void handleProcessFailure(async_data_item_t *sData)
     {
         if (sData->return_type == function_return_type_failure)
@@ -2021,15 +2274,17 @@ private:
 
         clear(host);
         port = 0;
-        client_changed = false;
-        network_changed = false;
+        if (sse_conn_selected)
+            sse_conn_restart = false;
+        else
+        {
+            client_changed = false;
+            network_changed = false;
+        }
     }
 
     async_data_item_t *createSlot(slot_options_t &options)
     {
-        if (!options.auth_used)
-            sse_events_filter.remove(0, sse_events_filter.length());
-
         int slot_index = sMan(options);
         // Only one SSE mode is allowed
         if (slot_index == -2)
@@ -2046,6 +2301,7 @@ private:
         sData->request.val[req_hndlr_ns::path] = path;
         sData->request.method = method;
         sData->sse = options.sse;
+        sData->request_ms = millis();
         sData->request.val[req_hndlr_ns::etag] = reqEtag;
 
         clear(reqEtag);
@@ -2160,8 +2416,32 @@ private:
 #endif
         closeFile(sData);
         setLastError(sData);
+
+        // The request statistics excluding the auth and SSE mode tasks.
+        if (!sData->auth_used && !sData->sse && sData->request_ms > 0)
+        {
+            request_count++;
+            latency_ms += millis() - sData->request_ms;
+            if (sData->error.code < 0 || sData->response.httpCode >= FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST)
+                error_count++;
+        }
+
         // data available from sync and asyn request except for sse
-        returnResult(sData, true);
+        // The result of silent write is returned only when error.
+        if (!sData->silent || sData->error.code < 0 || sData->response.httpCode >= FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST)
+            returnResult(sData, true);
+
+        // The dedicated SSE connection is kept open until its task was removed.
+        if (sData->sse && (sse_conn_selected ? client : sse_client))
+        {
+            bool selected = sse_conn_selected;
+            if (!selected)
+                swapConnection();
+            stop(sData);
+            if (!selected)
+                swapConnection();
+        }
+
         reset(sData, sData->auth_used);
         if (!sData->auth_used)
             delete sData;
@@ -2173,6 +2453,8 @@ private:
 
     void exitProcess(bool status)
     {
+        // Always leave the primary connection selected outside the process loop.
+        selectConnection(nullptr);
         inProcess = status;
     }
 
@@ -2190,6 +2472,8 @@ private:
             if (!sData)
                 return exitProcess(false);
 
+            selectConnection(sData);
+
             updateDebug(app_debug);
             updateEvent(app_event);
             sData->aResult.updateData();
@@ -2217,7 +2501,7 @@ private:
                 return exitProcess(false);
 
             // Restart connection when authenticate, client or network changed
-            if ((sData->sse && sData->auth_ts != auth_ts) || client_changed || network_changed)
+            if ((sData->sse && sData->auth_ts != auth_ts) || (sse_conn_selected ? sse_conn_restart : (client_changed || network_changed)))
             {
                 stop(sData);
                 sData->state = async_state_send_header;
@@ -2256,6 +2540,11 @@ private:
                 if (sData->return_type == function_return_type_complete)
                     sData->return_type = function_return_type_continue;
 
+#if defined(ENABLE_DATABASE)
+                if (sData->sse)
+                    returnQueuedEvent(sData);
+#endif
+
                 if (sData->async && !sData->response.tcpAvailable(client_type, client, async_tcp_config))
                 {
                     if (sData->sse)
@@ -2264,8 +2553,8 @@ private:
                         handleEventTimeout(sData);
 #endif
                     }
-                    else
-                        handleReadTimeout(sData);
+                    else if (!handleReadTimeout(sData))
+                        sendPipelined(sData);
                     return exitProcess(false);
                 }
                 else if (!sData->async) // wait for non async
@@ -2352,9 +2641,17 @@ public:
     {
         stop(nullptr);
 
+        if (sse_client)
+        {
+            swapConnection();
+            stop(nullptr);
+            swapConnection();
+        }
+
         for (size_t i = 0; i < sVec.size(); i++)
         {
-            reset(getData(i), true);
+            // The connections were already closed.
+            reset(getData(i), false);
             async_data_item_t *sData = getData(i);
             delete sData;
             sData = nullptr;
@@ -2417,6 +2714,37 @@ public:
      */
     size_t taskCount() const { return slotCount(); }
 
+    /**
+     * Get the number of completed requests excluding the auth and SSE mode (HTTP Streaming) tasks.
+     *
+     * @return uint32_t The number of completed requests.
+     */
+    uint32_t requestCount() const { return request_count; }
+
+    /**
+     * Get the number of completed requests that were failed (client error or HTTP status code 400 or greater).
+     *
+     * @return uint32_t The number of failed requests.
+     */
+    uint32_t errorCount() const { return error_count; }
+
+    /**
+     * Get the average time in milliseconds from the request was created until it was completed.
+     *
+     * @return uint32_t The average latency in milliseconds.
+     */
+    uint32_t averageLatency() const { return request_count ? latency_ms / request_count : 0; }
+
+    /**
+     * Reset the request, error and latency statistics.
+     */
+    void resetStats()
+    {
+        request_count = 0;
+        error_count = 0;
+        latency_ms = 0;
+    }
+
     /**
      * Get the last error information from async client.
      *
@@ -2461,6 +2789,50 @@ public:
      */
     void setSessionTimeout(uint32_t timeoutSec) { session_timeout_sec = timeoutSec; }
 
+    /**
+     * Set the dedicated SSL client for the SSE mode (HTTP Streaming) task.
+     *
+     * @param client The SSL client that working with the same network interface as the primary client.
+     *
+     * When this client was set, the SSE mode task keeps its server connection open on this client
+     * while other sync and async tasks are sent through the primary client.
+     * Then the stream does not need to reconnect and re-download the initial data after other tasks are complete.
+     *
+     * This is only available for the sync TCP client (Client) usage.
+     */
+    void setStreamClient(Client &client)
+    {
+        if (sse_conn_selected)
+            swapConnection();
+
+        if (sse_client && sse_client != &client)
+            sse_client->stop();
+
+        sse_client = &client;
+        clear(sse_host);
+        sse_port = 0;
+        sse_conn_sse = false;
+    }
+
+    /**
+     * Unset the dedicated SSL client for the SSE mode (HTTP Streaming) task.
+     *
+     * The SSE mode task will share the primary client with other tasks.
+     */
+    void unsetStreamClient()
+    {
+        if (sse_conn_selected)
+            swapConnection();
+
+        if (sse_client)
+            sse_client->stop();
+
+        sse_client = nullptr;
+        clear(sse_host);
+        sse_port = 0;
+        sse_conn_sse = false;
+    }
+
     /**
      * Get the network disconnection time.
      *
@@ -2493,6 +2865,10 @@ public:
         if (client_changed && this->client)
             this->client->stop();
 
+        // The dedicated SSE connection should be restarted on the new network.
+        if (sse_client)
+            sse_conn_restart = true;
+
         // Change the network interface.
         // Should not check the type changes, just overwrite
         this->net.copy(net);
@@ -53,6 +53,10 @@
 #endif
 #endif
 
+#if !defined(FIREBASE_PIPELINE_DEPTH)
+#define FIREBASE_PIPELINE_DEPTH 4
+#endif
+
 typedef void (*NetworkStatus)(bool &status);
 typedef void (*NetworkReconnect)(void);
 
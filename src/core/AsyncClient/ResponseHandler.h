@@ -27,6 +27,10 @@
 #include <Arduino.h>
 #include <Client.h>
 #include "RequestHandler.h"
+#include "./core/SSEParser.h"
+#include "./core/SSEQueue.h"
+#include "./core/SSECoalescer.h"
+#include "./core/JsonStreamParser.h"
 
 #define FIREBASE_TCP_READ_TIMEOUT_SEC 30 // Do not change
 
@@ -98,6 +102,15 @@ public:
     chunk_info_t chunkInfo;
     Timer read_timer;
     bool auth_data_available = false;
+#if defined(ENABLE_DATABASE)
+    SSEParser sse_parser;
+    // The queued and coalescing events are kept when the response was cleared for the Stream reconnection.
+    SSEQueue sse_queue;
+    SSECoalescer sse_coalescer;
+#endif
+#if defined(ENABLE_FIRESTORE)
+    JsonStreamParser array_parser;
+#endif
 
     async_response_handler_t()
     {
@@ -130,6 +143,12 @@ public:
         chunkInfo.chunkSize = 0;
         chunkInfo.dataLen = 0;
         chunkInfo.phase = READ_CHUNK_SIZE;
+#if defined(ENABLE_DATABASE)
+        sse_parser.reset();
+#endif
+#if defined(ENABLE_FIRESTORE)
+        array_parser.reset();
+#endif
     }
 
     void feedTimer(int interval = -1)
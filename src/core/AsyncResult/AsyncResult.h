@@ -36,6 +36,7 @@
 #include "./core/AsyncResult/ResultBase.h"
 #include "./core/AsyncResult/AppData.h"
 #include "./core/AsyncResult/AppProgress.h"
+#include "./core/JsonReader.h"
 
 using namespace firebase;
 
@@ -47,6 +48,7 @@ namespace ares_ns
         res_etag,
         data_path,
         data_payload,
+        res_session_id,
         max_type
     };
 }
@@ -56,6 +58,7 @@ class AsyncResult : public ResultBase, RealtimeDatabaseResult
     friend class AsyncClientClass;
     friend class AppBase;
     friend class RealtimeDatabase;
+    friend class DatabaseSocket;
     friend class Messaging;
     friend class Functions;
     friend class Storage;
@@ -107,6 +110,7 @@ private:
 #if defined(ENABLE_DATABASE)
     RealtimeDatabaseResult rtdbResult;
 #endif
+    JsonReader json_reader;
 
     void setPayload(const String &data)
     {
@@ -115,6 +119,7 @@ private:
             app_data.setData();
             val[ares_ns::data_payload] = data;
         }
+        json_reader.clear();
 #if defined(ENABLE_DATABASE)
         setRefPayload(&rtdbResult, &val[ares_ns::data_payload]);
 #endif
@@ -224,6 +229,32 @@ public:
      */
     String payload() const { return val[ares_ns::data_payload].c_str(); }
 
+    /**
+     * Get the JSON reader of server response payload.
+     *
+     * @return JsonReader The reference to JsonReader object.
+     *
+     * The payload is parsed once when this was called after the payload changed, then any number of values can be read by their paths.
+     * For SSE mode (HTTP Streaming) task, the event data (RealtimeDatabaseResult::data) is parsed.
+     */
+    JsonReader &json()
+    {
+        const char *json = val[ares_ns::data_payload].c_str();
+        size_t len = val[ares_ns::data_payload].length();
+#if defined(ENABLE_DATABASE)
+        size_t p1 = 0, p2 = 0;
+        if (getSSEData(&rtdbResult, p1, p2) && p2 <= len)
+        {
+            json += p1;
+            len = p2 - p1;
+        }
+#endif
+        // The reader that was copied from other result or not parsed.
+        if (json_reader.source() != json || json_reader.sourceLength() != len)
+            json_reader.parse(json, len);
+        return json_reader;
+    }
+
     /**
      * Get the path of the resource of the request.
      *
@@ -39,6 +39,7 @@
 #include "./core/AsyncResult/AppEvent.h"
 #include "./core/AsyncResult/AppDebug.h"
 #include "./core/AsyncResult/AppData.h"
+#include "./core/SSEParser.h"
 
 namespace firebase
 {
@@ -65,7 +66,10 @@ namespace firebase
         bool sse = false;
         event_resume_status_t event_resume_status = event_resume_status_undefined;
         String node_name, etag;
-        uint16_t data_path_p1 = 0, data_path_p2 = 0, event_p1 = 0, event_p2 = 0, data_p1 = 0, data_p2 = 0;
+        sse_event_type event_type = sse_event_type_undefined;
+        size_t data_path_p1 = 0, data_path_p2 = 0, event_p1 = 0, event_p2 = 0, data_p1 = 0, data_p2 = 0;
+        uint32_t queued_events = 0, lost_events = 0, coalesced_events = 0;
+        uint8_t transaction_attempts = 0;
         bool null_etag = false;
         String *ref_payload = nullptr;
 
@@ -77,6 +81,7 @@ namespace firebase
             event_p2 = 0;
             data_p1 = 0;
             data_p2 = 0;
+            event_type = sse_event_type_undefined;
             sse = false;
             event_resume_status = event_resume_status_undefined;
         }
@@ -91,55 +96,26 @@ namespace firebase
             }
         }
 
-        void parseSSE()
+        // Feed the event timer which also used for the filtered out events.
+        void feedSSE(sse_event_type type)
         {
-            clearSSE();
-            int p1 = 0, p2 = 0;
-            sut.parse(*ref_payload, "event", "\n", p1, p2);
-            if (p1 > -1 && p2 > -1)
-            {
-                event_p1 = p1;
-                event_p2 = p2;
-                p1 = p2;
-                setEventResumeStatus(event_resume_status_undefined);
-                sse_timer.feed(String(event()).indexOf("cancel") > -1 || String(event()).indexOf("auth_revoked") > -1 ? 0 : FIREBASE_SSE_TIMEOUT_MS / 1000);
-                sse = true;
-            }
+            setEventResumeStatus(event_resume_status_undefined);
+            sse_timer.feed(type == sse_event_type_cancel || type == sse_event_type_auth_revoked ? 0 : FIREBASE_SSE_TIMEOUT_MS / 1000);
+            sse = true;
+        }
 
-            sut.parse(*ref_payload, "data", "\n", p1, p2);
-            if (p1 > -1 && p2 > -1)
-            {
-                int p3 = p1, p4 = p2;
-                if (ref_payload->substring(p1, p2) == "null")
-                {
-                    data_p1 = p1;
-                    data_p2 = p2;
-                    return;
-                }
-
-                sut.parse(*ref_payload, "\"path\"", ",", p1, p2);
-                if (p1 > -1 && p2 > -1)
-                {
-                    data_path_p1 = p1 + 1;
-                    data_path_p2 = p2 - 1;
-                    p1 = p2;
-                }
-
-                sut.parse(*ref_payload, "\"data\"", "\n", p1, p2);
-                if (p1 > -1 && p2 > -1)
-                {
-                    if ((*ref_payload)[p2 - 1] == '}')
-                        p2--;
-                    data_p1 = p1;
-                    data_p2 = p2;
-                }
-
-                if (data_p1 == 0)
-                {
-                    data_p1 = p3;
-                    data_p2 = p4;
-                }
-            }
+        // Set the event from the positions in payload that parsed by SSEParser.
+        void setSSE(const sse_event_t &ev)
+        {
+            clearSSE();
+            event_type = ev.type;
+            event_p1 = ev.event_p1;
+            event_p2 = ev.event_p2;
+            data_path_p1 = ev.path_p1;
+            data_path_p2 = ev.path_p2;
+            data_p1 = ev.data_p1;
+            data_p2 = ev.data_p2;
+            sse = true;
         }
 
         void setEventResumeStatus(event_resume_status_t status) { event_resume_status = status; }
@@ -150,7 +126,22 @@ namespace firebase
         void setRefPayload(RealtimeDatabaseResult *rtdbResult, String *payload) { rtdbResult->ref_payload = payload; }
         void clearSSE(RealtimeDatabaseResult *rtdbResult) { rtdbResult->clearSSE(); }
         void parseNodeName(RealtimeDatabaseResult *rtdbResult) { rtdbResult->parseNodeName(); }
-        void parseSSE(RealtimeDatabaseResult *rtdbResult) { rtdbResult->parseSSE(); }
+        void setNodeName(RealtimeDatabaseResult *rtdbResult, const String &name) { rtdbResult->node_name = name; }
+        void setTransactionAttempts(RealtimeDatabaseResult *rtdbResult, uint8_t attempts) { rtdbResult->transaction_attempts = attempts; }
+        void feedSSE(RealtimeDatabaseResult *rtdbResult, sse_event_type type) { rtdbResult->feedSSE(type); }
+        void setSSE(RealtimeDatabaseResult *rtdbResult, const sse_event_t &ev) { rtdbResult->setSSE(ev); }
+        bool getSSEData(const RealtimeDatabaseResult *rtdbResult, size_t &p1, size_t &p2)
+        {
+            p1 = rtdbResult->data_p1;
+            p2 = rtdbResult->data_p2;
+            return rtdbResult->sse && p2 > p1;
+        }
+        void setSSEQueueStatus(RealtimeDatabaseResult *rtdbResult, uint32_t queued, uint32_t lost, uint32_t coalesced)
+        {
+            rtdbResult->queued_events = queued;
+            rtdbResult->lost_events = lost;
+            rtdbResult->coalesced_events = coalesced;
+        }
         void setEventResumeStatus(RealtimeDatabaseResult *rtdbResult, event_resume_status_t status) { rtdbResult->setEventResumeStatus(status); }
         event_resume_status_t eventResumeStatus(const RealtimeDatabaseResult *rtdbResult) { return rtdbResult->eventResumeStatus(); }
 
@@ -160,10 +151,23 @@ namespace firebase
         /**
          * Convert the RealtimeDatabaseResult to any type of values.
          *
-         * @return T The T type value e.g. boolean, integer, float, double and string.
+         * @return T The T type value e.g. boolean, integer, float, double, string and the struct that was bound with FIREBASE_JSON_BINDING.
          */
         template <typename T>
-        T to() { return vcon.to<T>(data().c_str()); }
+        auto to() -> typename std::enable_if<!json_binding<T>::bound, T>::type { return vcon.to<T>(data().c_str()); }
+
+        // The struct is decoded from the payload without copying the data.
+        template <typename T>
+        auto to() -> typename std::enable_if<json_binding<T>::bound, T>::type
+        {
+            T value;
+            if (ref_payload)
+            {
+                size_t p1 = data_p1 > 0 ? data_p1 : 0, p2 = data_p1 > 0 ? data_p2 : ref_payload->length();
+                JsonBinding::deserialize(ref_payload->c_str() + p1, p2 - p1, value);
+            }
+            return value;
+        }
 
         /**
          * Check if the async task is SSE mode (HTTP Streaming) task.
@@ -200,6 +204,14 @@ namespace firebase
          */
         String event() { return ref_payload ? ref_payload->substring(event_p1, event_p2).c_str() : ""; }
 
+        /**
+         * Get the `SSE mode (HTTP Streaming)` event type.
+         *
+         * @return sse_event_type The sse_event_type enum e.g. `sse_event_type_get` (the first put event since stream connected),
+         * `sse_event_type_put`, `sse_event_type_patch`, `sse_event_type_keep_alive`, `sse_event_type_cancel` and `sse_event_type_auth_revoked`.
+         */
+        sse_event_type eventType() const { return event_type; }
+
         /**
          * Get the SSE mode (HTTP Streaming) event data that has been changed.
          *
@@ -219,6 +231,38 @@ namespace firebase
          */
         bool eventTimeout() { return sse && sse_timer.remaining() == 0; }
 
+        /**
+         * Get the number of SSE mode (HTTP Streaming) events that are waiting in the events queue.
+         *
+         * @return uint32_t The number of queued events.
+         *
+         * The events queue can be set via RealtimeDatabase::setSSEQueue, the events that are pending in the time window
+         * of RealtimeDatabase::setSSECoalescing are also included.
+         */
+        uint32_t queuedEvents() const { return queued_events; }
+
+        /**
+         * Get the number of SSE mode (HTTP Streaming) events that were dropped because of events queue overflow.
+         *
+         * @return uint32_t The number of lost events.
+         */
+        uint32_t lostEvents() const { return lost_events; }
+
+        /**
+         * Get the number of queued SSE mode (HTTP Streaming) events that were replaced by the newer events,
+         * or merged within the time window of RealtimeDatabase::setSSECoalescing.
+         *
+         * @return uint32_t The number of coalesced events.
+         */
+        uint32_t coalescedEvents() const { return coalesced_events; }
+
+        /**
+         * Get the number of writes of RealtimeDatabase::transaction.
+         *
+         * @return uint8_t The number of writes, the writes after the first write were retried because the node was changed.
+         */
+        uint8_t transactionAttempts() const { return transaction_attempts; }
+
         /**
          * Get the type of Realtime database data.
          *
@@ -26,6 +26,7 @@
 #define VALUE_CONVERTER_H
 #include <Arduino.h>
 #include <string>
+#include "./core/JsonBinding.h"
 
 enum realtime_database_data_type
 {
@@ -238,6 +239,21 @@ public:
         }
     }
 
+    // The struct that was bound with FIREBASE_JSON_BINDING.
+    template <typename T>
+    auto getVal(String &buf, const T &value) -> typename std::enable_if<json_binding<T>::bound, void>::type
+    {
+        JsonBinding::serialize(buf, value);
+    }
+
+    template <typename T>
+    auto to(const char *payload) -> typename std::enable_if<json_binding<T>::bound, T>::type
+    {
+        T value;
+        JsonBinding::deserialize(payload, payload ? strlen(payload) : 0, value);
+        return value;
+    }
+
     template <typename T>
     auto to(const char *payload) -> typename std::enable_if<v_number<T>::value || std::is_same<T, bool>::value, T>::type
     {
@@ -87,6 +87,10 @@
 #define FIREBASE_ERROR_JWT_CREATION_REQUIRED -120
 #define FIREBASE_ERROR_INVALID_DATABASE_SECRET -121
 #define FIREBASE_ERROR_FW_UPDATE_OTA_STORAGE_CLASS_OBJECT_UNINITIALIZE -122
+#define FIREBASE_ERROR_OFFLINE_QUEUE_FULL -123
+#define FIREBASE_ERROR_TRANSACTION_ABORTED -124
+#define FIREBASE_ERROR_INVALID_JSON_DATA -125
+#define FIREBASE_ERROR_DATABASE_ROUTE -126
 
 #if !defined(FPSTR)
 #define FPSTR
@@ -98,6 +102,8 @@ class FirebaseError
 {
     friend class AsyncClientClass;
     friend class RealtimeDatabase;
+    friend class DatabaseSocket;
+    friend class DatabaseRouter;
     friend class FirestoreBase;
     friend class FirestoreDocuments;
     friend class FirestoreDatabase;
@@ -197,6 +203,18 @@ private:
             case FIREBASE_ERROR_INVALID_DATABASE_SECRET:
                 err.setError(code, FPSTR("invalid database secret"));
                 break;
+            case FIREBASE_ERROR_OFFLINE_QUEUE_FULL:
+                err.setError(code, FPSTR("offline queue is full"));
+                break;
+            case FIREBASE_ERROR_TRANSACTION_ABORTED:
+                err.setError(code, FPSTR("transaction was aborted"));
+                break;
+            case FIREBASE_ERROR_INVALID_JSON_DATA:
+                err.setError(code, FPSTR("invalid JSON data"));
+                break;
+            case FIREBASE_ERROR_DATABASE_ROUTE:
+                err.setError(code, FPSTR("database or async client of route is not available"));
+                break;
             default:
                 err.setError(code, FPSTR("undefined"));
                 break;
@@ -117,6 +117,121 @@ public:
         buf += '"';
         return buf;
     }
+
+    /* append the value as quoted JSON string, the quote, backslash and control characters are escaped */
+    void addString(String &buf, const String &value)
+    {
+        buf += '"';
+        for (size_t i = 0; i < value.length(); i++)
+        {
+            char c = value[i];
+            if (c == '"' || c == '\\')
+            {
+                buf += '\\';
+                buf += c;
+            }
+            else if (c == '\n')
+                buf += "\\n";
+            else if (c == '\r')
+                buf += "\\r";
+            else if (c == '\t')
+                buf += "\\t";
+            else if ((uint8_t)c < 0x20)
+            {
+                const char *hex = "0123456789abcdef";
+                buf += "\\u00";
+                buf += hex[(c >> 4) & 0x0f];
+                buf += hex[c & 0x0f];
+            }
+            else
+                buf += c;
+        }
+        buf += '"';
+    }
+
+    /* get the characters of JSON string (without its quotes) with the escaped characters unescaped */
+    String unescape(const char *s, size_t len)
+    {
+        String out;
+        out.reserve(len);
+        for (size_t i = 0; i < len; i++)
+        {
+            char c = s[i];
+            if (c == '\\' && i + 1 < len)
+            {
+                c = s[++i];
+                if (c == 'n')
+                    c = '\n';
+                else if (c == 'r')
+                    c = '\r';
+                else if (c == 't')
+                    c = '\t';
+                else if (c == 'b')
+                    c = '\b';
+                else if (c == 'f')
+                    c = '\f';
+                else if (c == 'u' && i + 4 < len)
+                {
+                    uint32_t cp = hex4(s + i + 1);
+                    i += 4;
+
+                    // The surrogate pair e.g. \uD83D\uDE00 is one code point.
+                    if (cp >= 0xd800 && cp <= 0xdbff && i + 6 < len && s[i + 1] == '\\' && s[i + 2] == 'u')
+                    {
+                        uint32_t low = hex4(s + i + 3);
+                        if (low >= 0xdc00 && low <= 0xdfff)
+                        {
+                            cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                            i += 6;
+                        }
+                    }
+
+                    // The UTF-8 encoding of code point.
+                    if (cp < 0x80)
+                        out += (char)cp;
+                    else if (cp < 0x800)
+                    {
+                        out += (char)(0xc0 | (cp >> 6));
+                        out += (char)(0x80 | (cp & 0x3f));
+                    }
+                    else if (cp < 0x10000)
+                    {
+                        out += (char)(0xe0 | (cp >> 12));
+                        out += (char)(0x80 | ((cp >> 6) & 0x3f));
+                        out += (char)(0x80 | (cp & 0x3f));
+                    }
+                    else
+                    {
+                        out += (char)(0xf0 | (cp >> 18));
+                        out += (char)(0x80 | ((cp >> 12) & 0x3f));
+                        out += (char)(0x80 | ((cp >> 6) & 0x3f));
+                        out += (char)(0x80 | (cp & 0x3f));
+                    }
+                    continue;
+                }
+            }
+            out += c;
+        }
+        return out;
+    }
+
+private:
+    // The value of 4 hex digits of \uXXXX escape.
+    static uint32_t hex4(const char *s)
+    {
+        uint32_t cp = 0;
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            cp <<= 4;
+            if (s[i] >= '0' && s[i] <= '9')
+                cp |= s[i] - '0';
+            else if (s[i] >= 'a' && s[i] <= 'f')
+                cp |= s[i] - 'a' + 10;
+            else if (s[i] >= 'A' && s[i] <= 'F')
+                cp |= s[i] - 'A' + 10;
+        }
+        return cp;
+    }
 };
 
 class JsonWriter
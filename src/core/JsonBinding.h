@@ -0,0 +1,665 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CORE_JSON_BINDING_H
+#define CORE_JSON_BINDING_H
+
+#include <Arduino.h>
+#include <type_traits>
+
+// The number of decimal places of float and double values, the trailing zeros are removed.
+// The values that are smaller than 1e-4 or not smaller than 1e15 are written with exponent in full precision of their type.
+#if !defined(FIREBASE_JSON_BINDING_DECIMALS)
+#define FIREBASE_JSON_BINDING_DECIMALS 6
+#endif
+
+/**
+ * The JSON codec of struct which is generated by FIREBASE_JSON_BINDING.
+ *
+ * The struct that was not bound has bound as false.
+ */
+template <typename T>
+struct json_binding
+{
+    static const bool bound = false;
+};
+
+/**
+ * The JSON writer that appends the bound struct members to the buffer without creating the intermediate strings.
+ */
+class JsonBindWriter
+{
+public:
+    explicit JsonBindWriter(String &buf) : buf(buf) {}
+
+    void begin() { buf += '{'; }
+
+    void end() { buf += '}'; }
+
+    /**
+     * Append the object member.
+     *
+     * @param name The quoted member name and colon e.g. "\"name\":".
+     * @param value The member value.
+     */
+    template <typename T>
+    void member(const char *name, const T &value)
+    {
+        if (count++ > 0)
+            buf += ',';
+        buf += name;
+        write(value);
+    }
+
+    void write(bool value) { buf += value ? "true" : "false"; }
+
+    template <typename T>
+    auto write(T value) -> typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, void>::type
+    {
+        char num[21];
+        char *p = &num[sizeof(num) - 1];
+        *p = '\0';
+        bool negative = value < 0;
+        uint64_t v = negative ? (uint64_t)(-(int64_t)value) : (uint64_t)value;
+        do
+        {
+            *--p = '0' + v % 10;
+            v /= 10;
+        } while (v);
+        if (negative)
+            buf += '-';
+        buf += p;
+    }
+
+    template <typename T>
+    auto write(T value) -> typename std::enable_if<std::is_floating_point<T>::value, void>::type
+    {
+        double v = value;
+        // The JSON has no NaN and Infinity.
+        if (isnan(v) || isinf(v))
+        {
+            buf += "null";
+            return;
+        }
+
+        if (v < 0)
+        {
+            buf += '-';
+            v = -v;
+        }
+
+        // The small and large values are written with exponent, the mantissa has the significant digits of type.
+        int exp = 0;
+        uint8_t decimals = FIREBASE_JSON_BINDING_DECIMALS;
+        if (v > 0 && (v < 1e-4 || v >= 1e15))
+        {
+            exp = (int)floor(log10(v));
+            // The power of 10 of subnormal value is out of range of double.
+            v = exp < -300 ? v * 1e300 * pow(10, -exp - 300) : (exp < 0 ? v * pow(10, -exp) : v / pow(10, exp));
+            if (v >= 10)
+            {
+                v /= 10;
+                exp++;
+            }
+            else if (v < 1)
+            {
+                v *= 10;
+                exp--;
+            }
+            decimals = sizeof(T) > sizeof(float) ? 14 : 5;
+        }
+
+        uint64_t scale = 1;
+        for (uint8_t i = 0; i < decimals; i++)
+            scale *= 10;
+
+        // The mantissa of the largest values is not rounded up which is out of range of double.
+        uint64_t ip = (uint64_t)v, fp = (uint64_t)((v - ip) * scale + (exp < 308 ? 0.5 : 0));
+        if (fp >= scale)
+        {
+            ip++;
+            fp -= scale;
+        }
+
+        // The mantissa was rounded up to 10.
+        if (exp && ip == 10)
+        {
+            ip = 1;
+            exp++;
+        }
+
+        write(ip);
+
+        if (fp > 0)
+        {
+            char frac[FIREBASE_JSON_BINDING_DECIMALS > 14 ? FIREBASE_JSON_BINDING_DECIMALS + 2 : 16];
+            frac[0] = '.';
+            for (int i = decimals; i > 0; i--)
+            {
+                frac[i] = '0' + fp % 10;
+                fp /= 10;
+            }
+            int end = decimals;
+            while (frac[end] == '0')
+                end--;
+            frac[end + 1] = '\0';
+            buf += frac;
+        }
+
+        if (exp)
+        {
+            buf += 'e';
+            write(exp);
+        }
+    }
+
+    void write(const String &value) { write(value.c_str()); }
+
+    void write(const char *value)
+    {
+        buf += '"';
+        for (const char *p = value; p && *p; p++)
+        {
+            char c = *p;
+            if (c == '"' || c == '\\')
+            {
+                buf += '\\';
+                buf += c;
+            }
+            else if (c == '\n')
+                buf += "\\n";
+            else if (c == '\r')
+                buf += "\\r";
+            else if (c == '\t')
+                buf += "\\t";
+            else if ((uint8_t)c < 0x20)
+            {
+                const char *hex = "0123456789abcdef";
+                buf += "\\u00";
+                buf += hex[(c >> 4) & 0x0f];
+                buf += hex[c & 0x0f];
+            }
+            else
+                buf += c;
+        }
+        buf += '"';
+    }
+
+    // The nested struct.
+    template <typename T>
+    auto write(const T &value) -> typename std::enable_if<json_binding<T>::bound, void>::type
+    {
+        size_t n = count;
+        count = 0;
+        json_binding<T>::write(*this, value);
+        count = n;
+    }
+
+    // The placeholders e.g. object_t, string_t, number_t and boolean_t.
+    template <typename T>
+    auto write(const T &value) -> typename std::enable_if<std::is_base_of<Printable, T>::value && !json_binding<T>::bound, void>::type
+    {
+        buf += value.c_str();
+    }
+
+private:
+    String &buf;
+    size_t count = 0;
+};
+
+/**
+ * The single-pass JSON reader that decodes the object members into the bound struct members.
+ *
+ * The values are decoded from the JSON string as they are read, the unknown members are skipped.
+ */
+class JsonBindReader
+{
+public:
+    JsonBindReader(const char *json, size_t len) : s(json), len(len) {}
+
+    bool beginObject()
+    {
+        skipSpace();
+        if (pos >= len || s[pos] != '{')
+            return false;
+        pos++;
+        first = true;
+        return true;
+    }
+
+    /**
+     * Read the next member name of object.
+     *
+     * @param name The pointer to member name (without quotes) in JSON string.
+     * @param nameLen The length of member name.
+     * @return bool Returns false at the end of object or when JSON is invalid.
+     */
+    bool nextKey(const char *&name, size_t &nameLen)
+    {
+        skipSpace();
+        if (pos >= len)
+            return fail();
+
+        if (s[pos] == '}')
+        {
+            pos++;
+            first = false;
+            return false;
+        }
+
+        if (!first)
+        {
+            if (s[pos] != ',')
+                return fail();
+            pos++;
+            skipSpace();
+        }
+        first = false;
+
+        size_t p = pos;
+        if (!skipString())
+            return fail();
+        name = s + p + 1;
+        nameLen = pos - p - 2;
+
+        skipSpace();
+        if (pos >= len || s[pos] != ':')
+            return fail();
+        pos++;
+        skipSpace();
+        return true;
+    }
+
+    static bool keyIs(const char *name, size_t nameLen, const char *key) { return strlen(key) == nameLen && strncmp(name, key, nameLen) == 0; }
+
+    bool isNull()
+    {
+        if (pos + 4 <= len && strncmp(s + pos, "null", 4) == 0)
+        {
+            pos += 4;
+            return true;
+        }
+        return false;
+    }
+
+    void read(bool &value)
+    {
+        if (pos + 4 <= len && strncmp(s + pos, "true", 4) == 0)
+        {
+            value = true;
+            pos += 4;
+        }
+        else if (pos + 5 <= len && strncmp(s + pos, "false", 5) == 0)
+        {
+            value = false;
+            pos += 5;
+        }
+        else
+            skip();
+    }
+
+    template <typename T>
+    auto read(T &value) -> typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, void>::type
+    {
+        if (!isNumber())
+            return skip();
+
+        char *end = nullptr;
+        if (std::is_signed<T>::value)
+            value = (T)strtoll(s + pos, &end, 10);
+        else
+            value = (T)strtoull(s + pos, &end, 10);
+
+        // The fraction and exponent of number are truncated.
+        if (end && (*end == '.' || *end == 'e' || *end == 'E'))
+            value = (T)strtod(s + pos, &end);
+
+        advance(end);
+    }
+
+    template <typename T>
+    auto read(T &value) -> typename std::enable_if<std::is_floating_point<T>::value, void>::type
+    {
+        if (!isNumber())
+            return skip();
+
+        char *end = nullptr;
+        value = (T)strtod(s + pos, &end);
+        advance(end);
+    }
+
+    void read(String &value)
+    {
+        if (pos >= len || s[pos] != '"')
+            return skip();
+
+        value.remove(0, value.length());
+        pos++;
+        while (pos < len && s[pos] != '"')
+        {
+            char c = s[pos++];
+            if (c == '\\' && pos < len)
+            {
+                c = s[pos++];
+                if (c == 'n')
+                    c = '\n';
+                else if (c == 'r')
+                    c = '\r';
+                else if (c == 't')
+                    c = '\t';
+                else if (c == 'b')
+                    c = '\b';
+                else if (c == 'f')
+                    c = '\f';
+                else if (c == 'u' && pos + 4 <= len)
+                {
+                    unicode(value);
+                    continue;
+                }
+            }
+            value += c;
+        }
+        if (pos < len)
+            pos++;
+    }
+
+    // The nested struct.
+    template <typename T>
+    auto read(T &value) -> typename std::enable_if<json_binding<T>::bound, void>::type
+    {
+        if (pos >= len || s[pos] != '{')
+            return skip();
+
+        if (!json_binding<T>::read(*this, value))
+            valid = false;
+    }
+
+    // The placeholders are write only.
+    template <typename T>
+    auto read(T &) -> typename std::enable_if<std::is_base_of<Printable, T>::value && !json_binding<T>::bound, void>::type { skip(); }
+
+    // Skip the value.
+    void skip()
+    {
+        skipSpace();
+        if (pos >= len)
+            return;
+
+        if (s[pos] == '"')
+        {
+            if (!skipString())
+                fail();
+            return;
+        }
+
+        if (s[pos] == '{' || s[pos] == '[')
+        {
+            size_t depth = 0;
+            while (pos < len)
+            {
+                char c = s[pos];
+                if (c == '"')
+                {
+                    if (!skipString())
+                        return (void)fail();
+                    continue;
+                }
+                pos++;
+                if (c == '{' || c == '[')
+                    depth++;
+                else if ((c == '}' || c == ']') && --depth == 0)
+                    return;
+            }
+            fail();
+            return;
+        }
+
+        while (pos < len && s[pos] != ',' && s[pos] != '}' && s[pos] != ']' && s[pos] != ' ' && s[pos] != '\t' && s[pos] != '\r' && s[pos] != '\n')
+            pos++;
+    }
+
+    // Returns true when the JSON was read without error.
+    bool ok() const { return valid; }
+
+private:
+    const char *s = nullptr;
+    size_t len = 0, pos = 0;
+    bool first = true, valid = true;
+
+    bool fail()
+    {
+        valid = false;
+        pos = len;
+        return false;
+    }
+
+    void skipSpace()
+    {
+        while (pos < len && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\r' || s[pos] == '\n'))
+            pos++;
+    }
+
+    bool skipString()
+    {
+        if (pos >= len || s[pos] != '"')
+            return false;
+        pos++;
+        while (pos < len && s[pos] != '"')
+            pos += s[pos] == '\\' ? 2 : 1;
+        if (pos >= len)
+            return false;
+        pos++;
+        return true;
+    }
+
+    bool isNumber() const { return pos < len && (s[pos] == '-' || (s[pos] >= '0' && s[pos] <= '9')); }
+
+    void advance(const char *end)
+    {
+        if (end && end > s + pos && end <= s + len)
+            pos = end - s;
+        else
+            skip();
+    }
+
+    // Read the 4 hex digits of \uXXXX escape.
+    uint32_t hex4()
+    {
+        uint32_t cp = 0;
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            char c = s[pos++];
+            cp <<= 4;
+            if (c >= '0' && c <= '9')
+                cp |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                cp |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                cp |= c - 'A' + 10;
+        }
+        return cp;
+    }
+
+    // Append the \uXXXX escaped character as UTF-8, the surrogate pair e.g. \uD83D\uDE00 is one 4-byte character.
+    void unicode(String &value)
+    {
+        uint32_t cp = hex4();
+        if (cp >= 0xd800 && cp <= 0xdbff && pos + 6 <= len && s[pos] == '\\' && s[pos + 1] == 'u')
+        {
+            size_t high_end = pos;
+            pos += 2;
+            uint32_t low = hex4();
+            if (low >= 0xdc00 && low <= 0xdfff)
+                cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+            else
+                pos = high_end;
+        }
+
+        if (cp < 0x80)
+            value += (char)cp;
+        else if (cp < 0x800)
+        {
+            value += (char)(0xc0 | (cp >> 6));
+            value += (char)(0x80 | (cp & 0x3f));
+        }
+        else if (cp < 0x10000)
+        {
+            value += (char)(0xe0 | (cp >> 12));
+            value += (char)(0x80 | ((cp >> 6) & 0x3f));
+            value += (char)(0x80 | (cp & 0x3f));
+        }
+        else
+        {
+            value += (char)(0xf0 | (cp >> 18));
+            value += (char)(0x80 | ((cp >> 12) & 0x3f));
+            value += (char)(0x80 | ((cp >> 6) & 0x3f));
+            value += (char)(0x80 | (cp & 0x3f));
+        }
+    }
+};
+
+/**
+ * The JSON serializer and deserializer of the struct that was bound with FIREBASE_JSON_BINDING.
+ */
+class JsonBinding
+{
+public:
+    /**
+     * Serialize the struct to JSON object.
+     *
+     * @param buf The output buffer which is cleared and its capacity is kept then it can be reused.
+     * @param value The struct.
+     */
+    template <typename T>
+    static auto serialize(String &buf, const T &value) -> typename std::enable_if<json_binding<T>::bound, void>::type
+    {
+        buf.remove(0, buf.length());
+        JsonBindWriter writer(buf);
+        json_binding<T>::write(writer, value);
+    }
+
+    /**
+     * Deserialize the JSON object to the struct.
+     *
+     * @param json The JSON object.
+     * @param len The length of JSON object.
+     * @param value The struct. The members that are missing or null in JSON object keep their values.
+     * @return bool Returns true if the JSON object is valid.
+     */
+    template <typename T>
+    static auto deserialize(const char *json, size_t len, T &value) -> typename std::enable_if<json_binding<T>::bound, bool>::type
+    {
+        if (!json)
+            return false;
+        JsonBindReader reader(json, len);
+        return json_binding<T>::read(reader, value) && reader.ok();
+    }
+
+    template <typename T>
+    static auto deserialize(const String &json, T &value) -> typename std::enable_if<json_binding<T>::bound, bool>::type
+    {
+        return deserialize(json.c_str(), json.length(), value);
+    }
+};
+
+#define FIREBASE_JSON_BINDING_NARG(...) FIREBASE_JSON_BINDING_NARG_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define FIREBASE_JSON_BINDING_NARG_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define FIREBASE_JSON_BINDING_CAT(a, b) FIREBASE_JSON_BINDING_CAT_(a, b)
+#define FIREBASE_JSON_BINDING_CAT_(a, b) a##b
+#define FIREBASE_JSON_BINDING_EACH(m, ...) FIREBASE_JSON_BINDING_CAT(FIREBASE_JSON_BINDING_EACH_, FIREBASE_JSON_BINDING_NARG(__VA_ARGS__))(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_1(m, f) m(f)
+#define FIREBASE_JSON_BINDING_EACH_2(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_1(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_3(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_2(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_4(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_3(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_5(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_4(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_6(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_5(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_7(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_6(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_8(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_7(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_9(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_8(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_10(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_9(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_11(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_10(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_12(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_11(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_13(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_12(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_14(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_13(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_15(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_14(m, __VA_ARGS__)
+#define FIREBASE_JSON_BINDING_EACH_16(m, f, ...) m(f) FIREBASE_JSON_BINDING_EACH_15(m, __VA_ARGS__)
+
+#define FIREBASE_JSON_BINDING_WRITE(f) writer.member("\"" #f "\":", value.f);
+#define FIREBASE_JSON_BINDING_READ(f)                        \
+    else if (JsonBindReader::keyIs(name, nameLen, #f))       \
+    {                                                        \
+        if (!reader.isNull())                                \
+            reader.read(value.f);                            \
+    }
+
+/**
+ * Bind the struct members to the JSON object members of the same names.
+ *
+ * ### Example
+ * ```cpp
+ * struct Device
+ * {
+ *     int id = 0;
+ *     float temperature = 0;
+ *     bool on = false;
+ *     String name;
+ * };
+ *
+ * FIREBASE_JSON_BINDING(Device, id, temperature, on, name)
+ * ```
+ * This should be placed in the global namespace after the struct was declared, up to 16 members are supported.
+ *
+ * The member types can be bool, integer, float, double, String, the placeholders (object_t, string_t, number_t and boolean_t, write only)
+ * and the struct that was bound.
+ */
+#define FIREBASE_JSON_BINDING(Type, ...)                                                   \
+    template <>                                                                            \
+    struct json_binding<Type>                                                              \
+    {                                                                                      \
+        static const bool bound = true;                                                    \
+        static void write(JsonBindWriter &writer, const Type &value)                       \
+        {                                                                                  \
+            writer.begin();                                                                \
+            FIREBASE_JSON_BINDING_EACH(FIREBASE_JSON_BINDING_WRITE, __VA_ARGS__)           \
+            writer.end();                                                                  \
+        }                                                                                  \
+        static bool read(JsonBindReader &reader, Type &value)                              \
+        {                                                                                  \
+            if (!reader.beginObject())                                                     \
+                return false;                                                              \
+            const char *name = nullptr;                                                    \
+            size_t nameLen = 0;                                                            \
+            while (reader.nextKey(name, nameLen))                                          \
+            {                                                                              \
+                if (false)                                                                 \
+                {                                                                          \
+                }                                                                          \
+                FIREBASE_JSON_BINDING_EACH(FIREBASE_JSON_BINDING_READ, __VA_ARGS__)        \
+                else reader.skip();                                                        \
+            }                                                                              \
+            return reader.ok();                                                            \
+        }                                                                                  \
+    };
+
+#endif
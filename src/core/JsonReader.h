@@ -0,0 +1,488 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CORE_JSON_READER_H
+#define CORE_JSON_READER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/StringUtil.h"
+#include "./core/AsyncResult/Value.h"
+
+#if defined(ENABLE_FIRESTORE)
+namespace Firestore
+{
+    class DocumentReader;
+}
+#endif
+
+#if defined(ENABLE_DATABASE)
+class DatabaseMirror;
+class DatabaseIterator;
+class SSECoalescer;
+#endif
+
+// The maximum nesting level of JSON to parse.
+#define FIREBASE_JSON_READER_MAX_DEPTH 64
+
+enum json_value_type
+{
+    json_value_type_undefined,
+    json_value_type_null,
+    json_value_type_boolean,
+    json_value_type_number,
+    json_value_type_string,
+    json_value_type_object,
+    json_value_type_array
+};
+
+/**
+ * The single-pass JSON parser that keeps the values positions (tape) of the JSON string without copying.
+ *
+ * The JSON string should not be changed or freed while the values are read.
+ *
+ * The value path is the JSON pointer or Realtime database path e.g. "/a/b/0" or "a/b/0".
+ */
+class JsonReader
+{
+#if defined(ENABLE_FIRESTORE)
+    friend class Firestore::DocumentReader;
+#endif
+#if defined(ENABLE_DATABASE)
+    friend class DatabaseMirror;
+    friend class DatabaseIterator;
+    friend class SSECoalescer;
+#endif
+
+public:
+    JsonReader() {}
+
+    /**
+     * Parse the JSON string.
+     *
+     * @param json The JSON string.
+     * @param len The length of JSON string.
+     * @return bool Returns true if JSON string is valid.
+     */
+    bool parse(const char *json, size_t len)
+    {
+        clear();
+        src = json;
+        src_len = len;
+
+        if (!json || !parseTape())
+        {
+            tape.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool parse(const String &json) { return parse(json.c_str(), json.length()); }
+
+    /**
+     * Remove the parsed values.
+     */
+    void clear()
+    {
+        tape.clear();
+        src = nullptr;
+        src_len = 0;
+    }
+
+    /**
+     * Check if the JSON string was parsed successfully.
+     *
+     * @return bool Returns true if the JSON string was parsed.
+     */
+    bool isValid() const { return tape.size() > 0; }
+
+    // The parsed JSON string.
+    const char *source() const { return src; }
+
+    size_t sourceLength() const { return src_len; }
+
+    /**
+     * Check if the value at the path exists.
+     *
+     * @param path The JSON pointer or Realtime database path.
+     * @return bool Returns true if the value exists.
+     */
+    bool existed(const String &path) const { return find(path) > -1; }
+
+    /**
+     * Get the type of value at the path.
+     *
+     * @param path The JSON pointer or Realtime database path.
+     * @return json_value_type The json_value_type enum.
+     */
+    json_value_type type(const String &path) const
+    {
+        int index = find(path);
+        return index > -1 ? (json_value_type)tape[index].type : json_value_type_undefined;
+    }
+
+    /**
+     * Get the number of object members or array elements at the path.
+     *
+     * @param path The JSON pointer or Realtime database path.
+     * @return size_t The number of children.
+     */
+    size_t size(const String &path) const
+    {
+        int index = find(path);
+        if (index == -1 || (tape[index].type != json_value_type_object && tape[index].type != json_value_type_array))
+            return 0;
+
+        size_t count = 0;
+        for (uint32_t i = firstChild(index); i < tape[index].next; i = nextChild(i, tape[index].type))
+            count++;
+        return count;
+    }
+
+    /**
+     * Get the object member name at the path.
+     *
+     * @param path The JSON pointer or Realtime database path of object.
+     * @param index The index of member.
+     * @return String The member name.
+     */
+    String key(const String &path, size_t index) const
+    {
+        String out;
+        int obj = find(path);
+        if (obj == -1 || tape[obj].type != json_value_type_object)
+            return out;
+
+        uint32_t i = firstChild(obj);
+        for (size_t n = 0; n < index && i < tape[obj].next; n++)
+            i = nextChild(i, json_value_type_object);
+
+        if (i < tape[obj].next)
+            assign(out, src + tape[i].p1, tape[i].p2 - tape[i].p1);
+        return out;
+    }
+
+    /**
+     * Get the pointer to the raw JSON value at the path in the JSON string without copying.
+     *
+     * @param path The JSON pointer or Realtime database path.
+     * @param len The length of raw JSON value.
+     * @return const char * The pointer to the value or nullptr if value does not exist.
+     */
+    const char *raw(const String &path, size_t &len) const
+    {
+        int index = find(path);
+        len = 0;
+        if (index == -1)
+            return nullptr;
+
+        // The string value includes its quotes.
+        const token_t &tok = tape[index];
+        size_t q = tok.type == json_value_type_string ? 1 : 0;
+        len = tok.p2 - tok.p1 + 2 * q;
+        return src + tok.p1 - q;
+    }
+
+    /**
+     * Get the raw JSON value at the path.
+     *
+     * @param path The JSON pointer or Realtime database path.
+     * @return String The JSON value or empty string if value does not exist.
+     */
+    String get(const String &path) const
+    {
+        String out;
+        size_t len = 0;
+        const char *p = raw(path, len);
+        if (p)
+            assign(out, p, len);
+        return out;
+    }
+
+    /**
+     * Convert the value at the path to any type of values.
+     *
+     * @param path The JSON pointer or Realtime database path.
+     * @return T The T type value e.g. boolean, integer, float, double and string.
+     */
+    template <typename T>
+    T to(const String &path)
+    {
+        int index = find(path);
+        if (index > -1 && tape[index].type != json_value_type_object && tape[index].type != json_value_type_array &&
+            tape[index].type != json_value_type_string && tape[index].p2 - tape[index].p1 < sizeof(num_buf))
+        {
+            // The number and literal values are short.
+            memcpy(num_buf, src + tape[index].p1, tape[index].p2 - tape[index].p1);
+            num_buf[tape[index].p2 - tape[index].p1] = 0;
+            return vcon.to<T>(num_buf);
+        }
+        return vcon.to<T>(get(path).c_str());
+    }
+
+    /**
+     * Get the tape index of value at the path.
+     *
+     * @param path The JSON pointer or Realtime database path.
+     * @return int The index of value or -1 if value does not exist.
+     */
+    int find(const String &path) const
+    {
+        if (!isValid())
+            return -1;
+
+        uint32_t index = 0;
+        int p1 = 0, len = path.length();
+        while (p1 < len)
+        {
+            int p2 = path.indexOf('/', p1);
+            if (p2 == -1)
+                p2 = len;
+
+            if (p2 > p1)
+            {
+                int child = findChild(index, path.c_str() + p1, p2 - p1);
+                if (child == -1)
+                    return -1;
+                index = child;
+            }
+            p1 = p2 + 1;
+        }
+        return index;
+    }
+
+private:
+    struct token_t
+    {
+        // The value positions, the string position excludes its quotes.
+        uint32_t p1 = 0, p2 = 0;
+        // The tape index after this value and its children.
+        uint32_t next = 0;
+        uint8_t type = json_value_type_undefined;
+    };
+
+    std::vector<token_t> tape;
+    const char *src = nullptr;
+    size_t src_len = 0;
+    char num_buf[32];
+    ValueConverter vcon;
+
+    void assign(String &out, const char *s, size_t len) const
+    {
+        out.reserve(len);
+        for (size_t i = 0; i < len; i++)
+            out += s[i];
+    }
+
+    uint32_t firstChild(uint32_t index) const { return index + 1; }
+
+    // The object member is the key string followed by its value.
+    uint32_t nextChild(uint32_t index, uint8_t parentType) const { return parentType == json_value_type_object ? tape[index + 1].next : tape[index].next; }
+
+    // Compare the object key with the path segment, the JSON pointer ~1 and ~0 are unescaped.
+    bool keyEqual(const token_t &key, const char *seg, size_t len) const
+    {
+        const char *k = src + key.p1;
+        size_t klen = key.p2 - key.p1, i = 0, j = 0;
+        while (i < klen && j < len)
+        {
+            char c = seg[j];
+            if (c == '~' && j + 1 < len && (seg[j + 1] == '0' || seg[j + 1] == '1'))
+            {
+                c = seg[j + 1] == '0' ? '~' : '/';
+                j++;
+            }
+            if (k[i] != c)
+                return false;
+            i++;
+            j++;
+        }
+        return i == klen && j == len;
+    }
+
+    int findChild(uint32_t index, const char *seg, size_t len) const
+    {
+        const token_t &parent = tape[index];
+        if (parent.type == json_value_type_object)
+        {
+            for (uint32_t i = firstChild(index); i < parent.next; i = nextChild(i, parent.type))
+            {
+                if (keyEqual(tape[i], seg, len))
+                    return i + 1;
+            }
+        }
+        else if (parent.type == json_value_type_array)
+        {
+            size_t n = 0;
+            for (size_t j = 0; j < len; j++)
+            {
+                if (seg[j] < '0' || seg[j] > '9')
+                    return -1;
+                n = n * 10 + (seg[j] - '0');
+            }
+
+            for (uint32_t i = firstChild(index); i < parent.next; i = nextChild(i, parent.type))
+            {
+                if (n-- == 0)
+                    return i;
+            }
+        }
+        return -1;
+    }
+
+    bool isSpace(char c) const { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    void skipSpace(size_t &i) const
+    {
+        while (i < src_len && isSpace(src[i]))
+            i++;
+    }
+
+    bool isDelimiter(char c) const { return c == ',' || c == '}' || c == ']' || c == ':' || isSpace(c); }
+
+    // Add the string token, the position is after the opening quote.
+    bool addString(size_t &i)
+    {
+        token_t tok;
+        tok.type = json_value_type_string;
+        tok.p1 = ++i;
+        while (i < src_len && src[i] != '"')
+            i += src[i] == '\\' ? 2 : 1;
+        if (i >= src_len)
+            return false;
+        tok.p2 = i++;
+        tok.next = tape.size() + 1;
+        tape.push_back(tok);
+        return true;
+    }
+
+    bool addScalar(size_t &i)
+    {
+        token_t tok;
+        tok.p1 = i;
+        while (i < src_len && !isDelimiter(src[i]))
+            i++;
+        tok.p2 = i;
+
+        size_t len = tok.p2 - tok.p1;
+        const char *s = src + tok.p1;
+        if (len == 4 && strncmp(s, "null", 4) == 0)
+            tok.type = json_value_type_null;
+        else if ((len == 4 && strncmp(s, "true", 4) == 0) || (len == 5 && strncmp(s, "false", 5) == 0))
+            tok.type = json_value_type_boolean;
+        else if (len > 0 && (s[0] == '-' || (s[0] >= '0' && s[0] <= '9')))
+            tok.type = json_value_type_number;
+        else
+            return false;
+
+        tok.next = tape.size() + 1;
+        tape.push_back(tok);
+        return true;
+    }
+
+    bool parseTape()
+    {
+        // The tape indices of opened objects and arrays.
+        std::vector<uint32_t> stack;
+        bool valueExpected = true;
+        size_t i = 0;
+
+        while (true)
+        {
+            skipSpace(i);
+
+            if (!valueExpected && stack.size() == 0)
+                return i == src_len;
+
+            if (i >= src_len)
+                return false;
+
+            char c = src[i];
+            uint8_t parentType = stack.size() ? tape[stack.back()].type : (uint8_t)json_value_type_undefined;
+
+            if (valueExpected)
+            {
+                // The empty object or array.
+                if (stack.size() && tape.size() - 1 == stack.back() &&
+                    ((c == '}' && parentType == json_value_type_object) || (c == ']' && parentType == json_value_type_array)))
+                {
+                    valueExpected = false;
+                    continue;
+                }
+
+                if (parentType == json_value_type_object)
+                {
+                    if (c != '"' || !addString(i))
+                        return false;
+                    skipSpace(i);
+                    if (i >= src_len || src[i] != ':')
+                        return false;
+                    i++;
+                    skipSpace(i);
+                    if (i >= src_len)
+                        return false;
+                    c = src[i];
+                }
+
+                if (c == '{' || c == '[')
+                {
+                    if (stack.size() >= FIREBASE_JSON_READER_MAX_DEPTH)
+                        return false;
+                    token_t tok;
+                    tok.type = c == '{' ? json_value_type_object : json_value_type_array;
+                    tok.p1 = i++;
+                    stack.push_back(tape.size());
+                    tape.push_back(tok);
+                    continue;
+                }
+
+                if (c == '"' ? !addString(i) : !addScalar(i))
+                    return false;
+
+                valueExpected = false;
+                continue;
+            }
+
+            // After value, the separator or the end of object or array.
+            if (c == ',')
+            {
+                i++;
+                valueExpected = true;
+            }
+            else if ((c == '}' && parentType == json_value_type_object) || (c == ']' && parentType == json_value_type_array))
+            {
+                token_t &tok = tape[stack.back()];
+                tok.p2 = ++i;
+                tok.next = tape.size();
+                stack.pop_back();
+            }
+            else
+                return false;
+        }
+    }
+};
+
+#endif
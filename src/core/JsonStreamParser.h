@@ -0,0 +1,151 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CORE_JSON_STREAM_PARSER_H
+#define CORE_JSON_STREAM_PARSER_H
+
+#include <Arduino.h>
+#include "./Config.h"
+
+#if defined(ENABLE_FIRESTORE)
+
+/**
+ * The incremental parser that splits the top level JSON array into its elements while the bytes arrive.
+ *
+ * Only the current element is kept in the output string then the memory usage is bounded by the largest element.
+ * The payload that is not JSON array is written to the output string as it is.
+ */
+class JsonStreamParser
+{
+public:
+    enum parse_result
+    {
+        parse_result_continue,
+        parse_result_element
+    };
+
+    JsonStreamParser() {}
+
+    /**
+     * Set the payload to be the sequence of length-prefixed JSON arrays e.g. the WebChannel frames
+     * "51\n[[0,[...]]]", the elements of all arrays are returned and the length prefixes are skipped.
+     *
+     * @param enable Set to true to parse the framed payload.
+     */
+    void setFramed(bool enable) { framed = enable; }
+
+    void reset()
+    {
+        state = state_begin;
+        depth = 0;
+        in_string = false;
+        escape = false;
+    }
+
+    /**
+     * Parse the payload byte.
+     *
+     * @param c The byte to parse.
+     * @param out The output string of the current element which should be cleared by caller after the element was taken.
+     * @return parse_result The parse_result_element when the element is completed and ready in the output string or parse_result_continue.
+     */
+    parse_result parse(char c, String &out)
+    {
+        if (state == state_begin)
+        {
+            if (isSpace(c) || (framed && c != '['))
+                return parse_result_continue;
+            state = c == '[' ? state_array : state_passthrough;
+            if (state == state_array)
+                return parse_result_continue;
+        }
+
+        if (state != state_array)
+        {
+            // The white spaces after the array are not the payload.
+            if (state == state_passthrough || !isSpace(c))
+                out += c;
+            return parse_result_continue;
+        }
+
+        if (in_string)
+        {
+            out += c;
+            if (escape)
+                escape = false;
+            else if (c == '\\')
+                escape = true;
+            else if (c == '"')
+                in_string = false;
+            return parse_result_continue;
+        }
+
+        // The separator and the white spaces between elements.
+        if (depth == 0)
+        {
+            if (c == ']')
+                state = framed ? state_begin : state_end;
+
+            if (c == ',' || c == ']')
+            {
+                // The number, string and literal element is completed at its separator.
+                if (out.length())
+                    return parse_result_element;
+                return parse_result_continue;
+            }
+
+            if (isSpace(c))
+                return parse_result_continue;
+        }
+
+        out += c;
+
+        if (c == '"')
+            in_string = true;
+        else if (c == '{' || c == '[')
+            depth++;
+        else if ((c == '}' || c == ']') && depth > 0 && --depth == 0)
+            return parse_result_element;
+        return parse_result_continue;
+    }
+
+private:
+    enum parse_state
+    {
+        state_begin,
+        state_array,
+        state_end,
+        state_passthrough
+    };
+
+    parse_state state = state_begin;
+    uint16_t depth = 0;
+    bool in_string = false, escape = false, framed = false;
+
+    bool isSpace(char c) const { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+};
+
+#endif
+
+#endif
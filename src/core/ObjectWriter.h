@@ -38,33 +38,35 @@ private:
     JSONUtil jut;
 
 public:
+    // The member is added in place before the closing token.
     void addMember(String &buf, const String &v, bool isString, const String &token = "}}")
     {
         int p = buf.lastIndexOf(token);
-        String str = buf.substring(0, p);
-        str += ',';
+        if (p > -1)
+            buf.remove(p);
+        buf.reserve(buf.length() + v.length() + token.length() + 3);
+        buf += ',';
         // Add to object
         if (token[0] == '}')
         {
-            String tmp;
             if (isString)
-                tmp += '"';
-            tmp += v;
-            if (isString)
-                tmp += '"';
-            str += tmp.substring(1, tmp.length() - 1);
+                buf += v;
+            else
+            {
+                for (size_t i = 1; i + 1 < v.length(); i++)
+                    buf += v[i];
+            }
         }
         // Add to array
         else
         {
             if (isString)
-                str += '"';
-            str += v;
+                buf += '"';
+            buf += v;
             if (isString)
-                str += '"';
+                buf += '"';
         }
-        str += token;
-        buf = str;
+        buf += token;
     }
 
     void addObject(String &buf, const String &object, const String &token, bool clear = false)
@@ -80,7 +82,7 @@ public:
         }
     }
 
-    void addMapArrayMember(String *buf, size_t size, uint8_t index, const String &key, const String &memberValue, bool isString)
+    void addMapArrayMember(String *buf, size_t size, uint8_t index, const String &key, const String &memberValue, bool isString, bool compose = true)
     {
         if (index < size)
         {
@@ -93,18 +95,34 @@ public:
             else
                 addMember(buf[index], memberValue, isString, "]}");
 
-            getBuf(buf, size);
+            if (compose)
+                getBuf(buf, size);
         }
     }
 
+    // Compose the JSON object (the first buffer) from the members objects in the other buffers.
     void getBuf(String *buf, size_t size)
     {
+        size_t len = 2;
+        for (size_t i = 1; i < size; i++)
+            len += buf[i].length();
+
         clear(buf[0]);
+        buf[0].reserve(len);
         for (size_t i = 1; i < size; i++)
-            addObject(buf[0], buf[i], "}", i == 0);
+        {
+            if (buf[i].length() < 2)
+                continue;
+            buf[0] += buf[0].length() ? ',' : '{';
+            // The member object without its braces.
+            for (size_t j = 1; j + 1 < buf[i].length(); j++)
+                buf[0] += buf[i][j];
+        }
+        if (buf[0].length())
+            buf[0] += '}';
     }
 
-    void setObject(String *buf, size_t size, uint8_t index, const String &key, const String &value, bool isString, bool last)
+    void setObject(String *buf, size_t size, uint8_t index, const String &key, const String &value, bool isString, bool last, bool compose = true)
     {
         if (index < size)
         {
@@ -113,7 +131,8 @@ public:
                 clear(buf[index]);
                 jut.addObject(buf[index], key, value, isString, last);
             }
-            getBuf(buf, size);
+            if (compose)
+                getBuf(buf, size);
         }
     }
 
@@ -189,9 +208,19 @@ private:
         static bool const value = std::is_same<T, const char *>::value || std::is_same<T, std::string>::value || std::is_same<T, String>::value;
     };
 
+    // The members are stored in their buffers and the JSON object is composed when it was read.
+    bool pending = false;
+
     void setObject(String *buf, size_t bufSize, uint8_t index, const String &key, const String &value, bool isString, bool last)
     {
-        owriter.setObject(buf, bufSize, index, key, value, isString, last);
+        owriter.setObject(buf, bufSize, index, key, value, isString, last, false);
+        pending = true;
+    }
+
+    void addMapArrayMember(String *buf, size_t bufSize, uint8_t index, const String &key, const String &value, bool isString)
+    {
+        owriter.addMapArrayMember(buf, bufSize, index, key, value, isString, false);
+        pending = true;
     }
 
 public:
@@ -259,32 +288,45 @@ public:
     template <typename T1, typename T2>
     T1 append(T1 ret, bool value, String *buf, size_t bufSize, uint8_t index, const String &name)
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, owriter.getBoolStr(value), false);
+        addMapArrayMember(buf, bufSize, index, name, owriter.getBoolStr(value), false);
         return ret;
     }
 
     template <typename T1, typename T2>
     auto append(T1 ret, const T2 &value, String *buf, size_t bufSize, uint8_t index, const String &name) -> typename std::enable_if<v_number<T2>::value, T1>::type
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, sut.num2Str(value), false);
+        addMapArrayMember(buf, bufSize, index, name, sut.num2Str(value), false);
         return ret;
     }
 
     template <typename T1, typename T2>
     auto append(T1 ret, const T2 &value, String *buf, size_t bufSize, uint8_t index, const String &name) -> typename std::enable_if<v_sring<T2>::value, T1>::type
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, value, true);
+        addMapArrayMember(buf, bufSize, index, name, value, true);
         return ret;
     }
 
     template <typename T1, typename T2>
     auto append(T1 ret, const T2 &value, String *buf, size_t bufSize, uint8_t index, const String &name) -> typename std::enable_if<(!v_sring<T2>::value && !v_number<T2>::value && !std::is_same<T2, bool>::value), T1>::type
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, value.c_str(), false);
+        addMapArrayMember(buf, bufSize, index, name, value.c_str(), false);
         return ret;
     }
     void clear(String &buf) { buf.remove(0, buf.length()); }
-    void clear(String *buf, size_t bufSize) { owriter.clearBuf(buf, bufSize); }
+    void clear(String *buf, size_t bufSize)
+    {
+        owriter.clearBuf(buf, bufSize);
+        pending = false;
+    }
+
+    // Compose the JSON object once after the members were changed.
+    void compose(String *buf, size_t bufSize)
+    {
+        if (!pending)
+            return;
+        owriter.getBuf(buf, bufSize);
+        pending = false;
+    }
 };
 
 class BaseObjects : public Printable
@@ -293,18 +335,30 @@ class BaseObjects : public Printable
 protected:
     size_t bufferSize = 0;
     String *buffers = nullptr;
-    BufWriter wr;
+    // The JSON object is composed from c_str and printTo.
+    mutable BufWriter wr;
 
 public:
     BaseObjects() {}
+    // The copy keeps its own buffers, the derived object copies the buffer contents.
+    BaseObjects(const BaseObjects &rhs) : Printable(rhs), wr(rhs.wr) {}
+    BaseObjects &operator=(const BaseObjects &rhs)
+    {
+        wr = rhs.wr;
+        return *this;
+    }
     ~BaseObjects() { clear(); }
     void init(String *buffers, size_t size)
     {
         this->buffers = buffers;
         this->bufferSize = size;
     }
-    const char *c_str() const { return buffers[0].c_str(); }
-    size_t printTo(Print &p) const override { return p.print(buffers[0].c_str()); }
+    const char *c_str() const
+    {
+        wr.compose(buffers, bufferSize);
+        return buffers[0].c_str();
+    }
+    size_t printTo(Print &p) const override { return p.print(c_str()); }
     void clear() { wr.clear(buffers, bufferSize); }
     void setContent(const String &content)
     {
@@ -341,6 +395,20 @@ protected:
 
 public:
     BaseO2() { init(buf, bufSize); }
+    BaseO2(const BaseO2 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO2 &operator=(const BaseO2 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 class BaseO4 : public BaseObjects
@@ -351,6 +419,20 @@ protected:
 
 public:
     BaseO4() { init(buf, bufSize); }
+    BaseO4(const BaseO4 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO4 &operator=(const BaseO4 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 class BaseO6 : public BaseObjects
@@ -362,6 +444,20 @@ protected:
 
 public:
     BaseO6() { init(buf, bufSize); }
+    BaseO6(const BaseO6 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO6 &operator=(const BaseO6 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 class BaseO8 : public BaseObjects
@@ -372,6 +468,20 @@ protected:
 
 public:
     BaseO8() { init(buf, bufSize); }
+    BaseO8(const BaseO8 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO8 &operator=(const BaseO8 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 class BaseO10 : public BaseObjects
@@ -382,6 +492,20 @@ protected:
 
 public:
     BaseO10() { init(buf, bufSize); }
+    BaseO10(const BaseO10 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO10 &operator=(const BaseO10 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 class BaseO12 : public BaseObjects
@@ -392,6 +516,20 @@ protected:
 
 public:
     BaseO12() { init(buf, bufSize); }
+    BaseO12(const BaseO12 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO12 &operator=(const BaseO12 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 class BaseO16 : public BaseObjects
@@ -402,6 +540,20 @@ protected:
 
 public:
     BaseO16() { init(buf, bufSize); }
+    BaseO16(const BaseO16 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO16 &operator=(const BaseO16 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 class BaseO26 : public BaseObjects
@@ -412,6 +564,20 @@ protected:
 
 public:
     BaseO26() { init(buf, bufSize); }
+    BaseO26(const BaseO26 &rhs) : BaseObjects(rhs)
+    {
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+    }
+    BaseO26 &operator=(const BaseO26 &rhs)
+    {
+        BaseObjects::operator=(rhs);
+        init(buf, bufSize);
+        for (size_t i = 0; i < bufSize; i++)
+            buf[i] = rhs.buf[i];
+        return *this;
+    }
 };
 
 namespace firebase
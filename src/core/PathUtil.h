@@ -0,0 +1,71 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CORE_PATH_UTIL_H
+#define CORE_PATH_UTIL_H
+
+#include <Arduino.h>
+#include "./Config.h"
+
+/**
+ * The helpers of the slash separated resource paths e.g. the Realtime database paths and the Firestore document paths.
+ */
+class PathUtil
+{
+public:
+    /**
+     * Remove the leading and trailing slashes.
+     *
+     * @param path The path e.g. "/a/b/".
+     * @return String The path without the leading and trailing slashes e.g. "a/b".
+     */
+    static String normalize(const String &path)
+    {
+        size_t p1 = 0, p2 = path.length();
+        while (p1 < p2 && path[p1] == '/')
+            p1++;
+        while (p2 > p1 && path[p2 - 1] == '/')
+            p2--;
+        return path.substring(p1, p2);
+    }
+
+    /**
+     * Check if the path is the same path or under the parent path.
+     *
+     * @param path The path.
+     * @param parent The parent path, the trailing slashes are ignored and the empty or root path is the parent of all paths.
+     * @return bool Returns true if the path is the parent path or under it.
+     */
+    static bool under(const String &path, const String &parent)
+    {
+        size_t len = parent.length();
+        while (len && parent[len - 1] == '/')
+            len--;
+        if (len == 0)
+            return true;
+        return path.length() >= len && strncmp(path.c_str(), parent.c_str(), len) == 0 && (path.length() == len || path[len] == '/');
+    }
+};
+
+#endif
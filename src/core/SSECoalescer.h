@@ -0,0 +1,494 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CORE_SSE_COALESCER_H
+#define CORE_SSE_COALESCER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/JSON.h"
+#include "./core/PathUtil.h"
+#include "./core/SSEParser.h"
+#include "./core/JsonReader.h"
+
+#if defined(ENABLE_DATABASE)
+
+/**
+ * The SSE mode (HTTP Streaming) events that arrive within the time window are merged per path
+ * before they are returned.
+ *
+ * The put event replaces the pending events at the same path or under its path, the put and patch events
+ * are composed onto the pending put event at the same path or parent path, and the patch events at the
+ * same path are merged into one patch event. The pending events are kept in their order, the data after
+ * returning the merged events is the same as after returning every event.
+ *
+ * The keep-alive event is dropped while the events are pending, the other events e.g. cancel and auth_revoked
+ * close the window and are returned after the pending events.
+ */
+class SSECoalescer
+{
+public:
+    struct item_t
+    {
+        String payload;
+        sse_event_t event;
+    };
+
+    SSECoalescer() {}
+
+    /**
+     * Set the time window.
+     *
+     * @param window The milliseconds to wait for the events to merge since the first pending event
+     * was received or 0 to disable.
+     *
+     * The pending events and counter will be cleared.
+     */
+    void setWindow(uint32_t window)
+    {
+        this->window = window;
+        clear();
+        coalesced_count = 0;
+    }
+
+    bool enabled() const { return window > 0; }
+
+    // The number of pending events.
+    size_t size() const { return entries.size(); }
+
+    // The number of events that were merged into the pending events.
+    uint32_t coalesced() const { return coalesced_count; }
+
+    /**
+     * Add the event.
+     *
+     * @param payload The event payload.
+     * @param event The event positions in the payload.
+     * @return bool Returns true if the event was taken, false if the event should be returned as it is
+     * (the keep-alive event when nothing is pending).
+     */
+    bool push(const String &payload, const sse_event_t &event)
+    {
+        if (!enabled())
+            return false;
+
+        bool pending = entries.size() > closed;
+
+        if (event.type == sse_event_type_keep_alive)
+        {
+            if (pending)
+                coalesced_count++;
+            return pending;
+        }
+
+        entry_t e;
+        e.type = event.type;
+
+        bool data = event.type == sse_event_type_get || event.type == sse_event_type_put || event.type == sse_event_type_patch;
+        if (!data || event.path_p2 <= event.path_p1 || event.data_p2 <= event.data_p1)
+        {
+            // Returned after the pending events.
+            e.raw = true;
+            e.payload = payload;
+            e.event = event;
+            entries.push_back(e);
+            closed = entries.size();
+            ms = 0;
+            return true;
+        }
+
+        e.path = payload.substring(event.path_p1, event.path_p2);
+        e.data = payload.substring(event.data_p1, event.data_p2);
+
+        if (pending && merge(e))
+        {
+            coalesced_count++;
+            return true;
+        }
+
+        if (entries.size() == closed)
+            ms = millis();
+        entries.push_back(e);
+        return true;
+    }
+
+    /**
+     * Get the oldest event that is ready to return.
+     *
+     * @return item_t * The event or nullptr when the events are still pending in the time window.
+     */
+    item_t *front()
+    {
+        if (entries.size() > closed && millis() - ms >= window)
+        {
+            closed = entries.size();
+            ms = 0;
+        }
+
+        if (closed == 0)
+            return nullptr;
+
+        entry_t &e = entries[0];
+        if (e.raw)
+        {
+            item.payload = e.payload;
+            item.event = e.event;
+        }
+        else
+            build(e);
+
+        return &item;
+    }
+
+    // Remove the oldest event that is ready to return.
+    void pop()
+    {
+        if (closed == 0)
+            return;
+        entries.erase(entries.begin());
+        closed--;
+        item.payload.remove(0, item.payload.length());
+    }
+
+    // Remove all pending events, the time window and counter are kept.
+    void clear()
+    {
+        entries.clear();
+        closed = 0;
+        ms = 0;
+        item.payload.remove(0, item.payload.length());
+    }
+
+private:
+    struct entry_t
+    {
+        sse_event_type type = sse_event_type_undefined;
+        // The data path and JSON data of put and patch events.
+        String path, data;
+        // The payload of other events.
+        bool raw = false;
+        String payload;
+        sse_event_t event;
+    };
+
+    std::vector<entry_t> entries;
+    // The number of events (from the oldest) that were closed from merging.
+    size_t closed = 0;
+    uint32_t window = 0, coalesced_count = 0;
+    unsigned long ms = 0;
+    item_t item;
+
+    static bool isPut(const entry_t &e) { return !e.raw && (e.type == sse_event_type_get || e.type == sse_event_type_put); }
+
+    /**
+     * Merge the put or patch event into the pending events.
+     *
+     * @param e The put or patch event.
+     * @return bool Returns true if the event was merged into the last pending event, the pending events
+     * that were replaced by the put event were removed.
+     */
+    bool merge(entry_t &e)
+    {
+        bool merged = false;
+        entry_t &last = entries[entries.size() - 1];
+
+        if (isPut(last) && PathUtil::under(e.path, last.path))
+        {
+            std::vector<String> keys;
+            splitPath(e.path.substring(last.path.length()), keys);
+            if (e.type == sse_event_type_patch)
+                last.data = update(last.data, keys, e.data);
+            else
+                last.data = compose(last.data, keys, 0, e.data);
+            merged = true;
+        }
+        else if (!last.raw && last.type == sse_event_type_patch && e.type == sse_event_type_patch && samePath(e.path, last.path))
+        {
+            last.data = mergePatch(last.data, e.data);
+            merged = true;
+        }
+
+        if (e.type == sse_event_type_patch)
+            return merged;
+
+        // The pending events at the same path or under the path of put event were replaced.
+        size_t end = merged ? entries.size() - 1 : entries.size();
+        for (size_t i = end; i > closed; i--)
+        {
+            entry_t &p = entries[i - 1];
+            if (!p.raw && PathUtil::under(p.path, e.path))
+            {
+                // The put event that replaces the first put event since stream connected is the first put event.
+                if (p.type == sse_event_type_get)
+                    e.type = sse_event_type_get;
+                entries.erase(entries.begin() + (i - 1));
+                coalesced_count++;
+            }
+        }
+
+        return merged;
+    }
+
+    static bool samePath(const String &a, const String &b) { return PathUtil::under(a, b) && PathUtil::under(b, a); }
+
+    // The object member or array element, the key is unescaped and the value is raw JSON.
+    struct member_t
+    {
+        String key, value;
+    };
+
+    // Split the path (the characters of JSON string) to the unescaped keys.
+    static void splitPath(const String &path, std::vector<String> &keys)
+    {
+        JSONUtil jut;
+        splitKey(jut.unescape(path.c_str(), path.length()), keys);
+    }
+
+    /**
+     * Get the object members or array elements (the index keys) of JSON data in a single pass.
+     *
+     * @return json_value_type The type of JSON data.
+     */
+    static json_value_type members(const String &json, std::vector<member_t> &list)
+    {
+        JsonReader reader;
+        if (!reader.parse(json))
+            return json_value_type_undefined;
+
+        uint8_t type = reader.tape[0].type;
+        if (type != json_value_type_object && type != json_value_type_array)
+            return (json_value_type)type;
+
+        JSONUtil jut;
+        size_t index = 0;
+        for (uint32_t i = reader.firstChild(0); i < reader.tape[0].next; i = reader.nextChild(i, type))
+        {
+            member_t m;
+            uint32_t v = i;
+            if (type == json_value_type_object)
+            {
+                m.key = jut.unescape(json.c_str() + reader.tape[i].p1, reader.tape[i].p2 - reader.tape[i].p1);
+                v = i + 1;
+            }
+            else
+                m.key = String(index++);
+
+            // The string value includes its quotes.
+            const JsonReader::token_t &tok = reader.tape[v];
+            uint32_t q = tok.type == json_value_type_string ? 1 : 0;
+            m.value = json.substring(tok.p1 - q, tok.p2 + q);
+            list.push_back(m);
+        }
+        return (json_value_type)type;
+    }
+
+    static bool isNull(const String &json)
+    {
+        String s = json;
+        s.trim();
+        return s.length() == 0 || s == "null";
+    }
+
+    /**
+     * Build the JSON data from the members, the null members are removed.
+     *
+     * The array is kept as array when its index keys are still contiguous from 0, otherwise it is
+     * changed to object with the index keys. The data without members will be null.
+     */
+    static String toJson(const std::vector<member_t> &list, bool array)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (isNull(list[i].value))
+                continue;
+            if (array && list[i].key != String(count))
+                array = false;
+            count++;
+        }
+
+        if (count == 0)
+            return "null";
+
+        JSONUtil jut;
+        String out;
+        out += array ? '[' : '{';
+        count = 0;
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (isNull(list[i].value))
+                continue;
+            if (count++ > 0)
+                out += ',';
+            if (!array)
+            {
+                jut.addString(out, list[i].key);
+                out += ':';
+            }
+            out += list[i].value;
+        }
+        out += array ? ']' : '}';
+        return out;
+    }
+
+    /**
+     * Set the value at the path keys (from index) of JSON data.
+     *
+     * The null value removes the data at the path, the object without members will be null.
+     */
+    static String compose(const String &json, const std::vector<String> &keys, size_t index, const String &value)
+    {
+        if (index == keys.size())
+            return value;
+
+        std::vector<member_t> list;
+        bool array = members(json, list) == json_value_type_array;
+
+        bool found = false;
+        for (size_t i = 0; i < list.size() && !found; i++)
+        {
+            if (list[i].key == keys[index])
+            {
+                found = true;
+                list[i].value = compose(list[i].value, keys, index + 1, value);
+            }
+        }
+
+        if (!found)
+        {
+            member_t m;
+            m.key = keys[index];
+            m.value = compose("null", keys, index + 1, value);
+            list.push_back(m);
+        }
+
+        return toJson(list, array);
+    }
+
+    // Update the children (relative paths) of the data at the path keys of JSON data.
+    static String update(const String &json, const std::vector<String> &keys, const String &patch)
+    {
+        std::vector<member_t> list;
+        if (members(patch, list) != json_value_type_object)
+            return json;
+
+        String out = json;
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            std::vector<String> path = keys;
+            splitKey(list[i].key, path);
+            out = compose(out, path, 0, list[i].value);
+        }
+        return out;
+    }
+
+    // Split the unescaped key (relative path) of patch data.
+    static void splitKey(const String &key, std::vector<String> &keys)
+    {
+        int p1 = 0, len = key.length();
+        while (p1 < len)
+        {
+            int p2 = key.indexOf('/', p1);
+            if (p2 == -1)
+                p2 = len;
+            if (p2 > p1)
+                keys.push_back(key.substring(p1, p2));
+            p1 = p2 + 1;
+        }
+    }
+
+    // Merge the children of patch event into the pending patch event at the same path.
+    static String mergePatch(const String &json, const String &patch)
+    {
+        std::vector<member_t> o, n;
+        if (members(json, o) != json_value_type_object || members(patch, n) != json_value_type_object)
+            return patch;
+
+        for (size_t i = 0; i < n.size(); i++)
+        {
+            const String &key = n[i].key;
+            bool composed = false;
+            for (int j = o.size() - 1; j >= 0; j--)
+            {
+                if (PathUtil::under(key, o[j].key) && !samePath(key, o[j].key))
+                {
+                    // The child data under the pending child.
+                    std::vector<String> path;
+                    splitKey(key.substring(o[j].key.length()), path);
+                    o[j].value = compose(o[j].value, path, 0, n[i].value);
+                    if (isNull(o[j].value))
+                        o[j].value = "null";
+                    composed = true;
+                    break;
+                }
+                else if (PathUtil::under(o[j].key, key))
+                    o.erase(o.begin() + j);
+            }
+
+            if (!composed)
+                o.push_back(n[i]);
+        }
+
+        // The null children of patch data are kept, they remove the data.
+        JSONUtil jut;
+        String out = "{";
+        for (size_t i = 0; i < o.size(); i++)
+        {
+            if (i > 0)
+                out += ',';
+            jut.addString(out, o[i].key);
+            out += ':';
+            out += o[i].value;
+        }
+        out += '}';
+        return out;
+    }
+
+    // Build the event payload in the same format as SSEParser.
+    void build(const entry_t &e)
+    {
+        item.payload.remove(0, item.payload.length());
+        item.payload.reserve(e.path.length() + e.data.length() + 48);
+        item.event = sse_event_t();
+        item.event.type = e.type;
+        item.payload += "event: ";
+        item.event.event_p1 = item.payload.length();
+        item.payload += e.type == sse_event_type_patch ? "patch" : "put";
+        item.event.event_p2 = item.payload.length();
+        item.payload += "\ndata: {\"path\":\"";
+        item.event.path_p1 = item.payload.length();
+        item.payload += e.path;
+        item.event.path_p2 = item.payload.length();
+        item.payload += "\",\"data\":";
+        item.event.data_p1 = item.payload.length();
+        item.payload += e.data;
+        item.event.data_p2 = item.payload.length();
+        item.payload += "}\n";
+    }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,423 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CORE_SSE_PARSER_H
+#define CORE_SSE_PARSER_H
+
+#include <Arduino.h>
+#include "./Config.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The SSE mode (HTTP Streaming) event types.
+// The values are bit flags that can be combined as the events filter mask.
+enum sse_event_type
+{
+    sse_event_type_undefined = 0,
+    // The http get response (first put event since stream connected).
+    sse_event_type_get = 1 << 0,
+    sse_event_type_put = 1 << 1,
+    sse_event_type_patch = 1 << 2,
+    sse_event_type_keep_alive = 1 << 3,
+    sse_event_type_cancel = 1 << 4,
+    sse_event_type_auth_revoked = 1 << 5,
+    sse_event_type_unknown = 1 << 6
+};
+
+// The parsed event type and its event name, data path and data positions in the payload.
+struct sse_event_t
+{
+    sse_event_type type = sse_event_type_undefined;
+    size_t event_p1 = 0, event_p2 = 0, path_p1 = 0, path_p2 = 0, data_p1 = 0, data_p2 = 0;
+};
+
+/**
+ * The incremental text/event-stream parser.
+ *
+ * The stream bytes are fed as they arrive, the LF, CRLF and CR line endings, multi-line data
+ * and the frames that split across the TCP reads are supported.
+ *
+ * The frame is written to the output string as "event: <event>\ndata: <data>\n" where
+ * multi-line data are joined with '\n'. The event that does not pass the filter is dropped
+ * as soon as its event field was read, its data will not be copied.
+ */
+class SSEParser
+{
+public:
+    enum parse_result
+    {
+        parse_result_continue,
+        parse_result_event,
+        parse_result_dropped
+    };
+
+    SSEParser() {}
+
+    /**
+     * Set the events filter.
+     *
+     * @param mask The sse_event_type bits of the events to allow or 0 to allow all events.
+     */
+    void setFilter(uint8_t mask) { filter = mask; }
+
+    uint8_t getFilter() const { return filter; }
+
+    /**
+     * Reset the parser state, the filter is kept.
+     */
+    void reset()
+    {
+        resetFrame();
+        cr = false;
+        ev = sse_event_t();
+    }
+
+    /**
+     * Parse the stream byte.
+     *
+     * @param c The byte to parse.
+     * @param out The output string of the current frame which should be cleared by caller after the event was taken.
+     * @param initial Set to true when the frame is the first frame after the http response headers.
+     * @return parse_result The parse_result_event when the frame is completed and ready in the output string,
+     * parse_result_dropped when the completed frame was filtered out or parse_result_continue.
+     */
+    parse_result parse(char c, String &out, bool initial)
+    {
+        // The LF that follows the CR is the part of CRLF line ending.
+        if (c == '\n' && cr)
+        {
+            cr = false;
+            return parse_result_continue;
+        }
+
+        cr = c == '\r';
+
+        if (c == '\r' || c == '\n')
+            return endLine(out, initial);
+
+        if (field == field_name)
+        {
+            if (c == ':')
+                beginValue(out);
+            else if (name_len < sizeof(name))
+                name[name_len++] = c;
+            else
+                name_len = sizeof(name) + 1;
+            return parse_result_continue;
+        }
+
+        // A single leading space of the field value is not the part of value.
+        if (value_begin)
+        {
+            value_begin = false;
+            if (c == ' ')
+                return parse_result_continue;
+        }
+
+        if (field == field_event)
+            event_name += c;
+        else if (field == field_data)
+        {
+            if (!dropped)
+                out += c;
+        }
+        else if (field == field_id)
+            id_buf += c;
+        else if (field == field_retry)
+        {
+            if (c >= '0' && c <= '9')
+                retry_buf = retry_buf * 10 + (c - '0');
+            else
+                retry_invalid = true;
+        }
+
+        return parse_result_continue;
+    }
+
+    // The completed frame event type and positions in the output string.
+    const sse_event_t &event() const { return ev; }
+
+    // The last event ID and the reconnection time in milliseconds sent by server.
+    const String &lastEventId() const { return last_id; }
+    uint32_t retry() const { return retry_ms; }
+
+    /**
+     * Get the sse_event_type of event name.
+     *
+     * @param name The event name.
+     * @param len The event name length.
+     * @param initial Set to true when the event is the first event after the http response headers.
+     * @return sse_event_type The sse_event_type enum.
+     */
+    static sse_event_type getType(const char *name, size_t len, bool initial)
+    {
+        if (len == 3 && strncmp(name, "put", 3) == 0)
+            return initial ? sse_event_type_get : sse_event_type_put;
+        else if (len == 5 && strncmp(name, "patch", 5) == 0)
+            return sse_event_type_patch;
+        else if (len == 10 && strncmp(name, "keep-alive", 10) == 0)
+            return sse_event_type_keep_alive;
+        else if (len == 6 && strncmp(name, "cancel", 6) == 0)
+            return sse_event_type_cancel;
+        else if (len == 12 && strncmp(name, "auth_revoked", 12) == 0)
+            return sse_event_type_auth_revoked;
+        return sse_event_type_unknown;
+    }
+
+    /**
+     * Convert the event keywords to the filter mask.
+     *
+     * @param keywords The event keywords e.g. "get,put,patch,keep-alive,cancel,auth_revoked".
+     * @return uint8_t The filter mask or 0 to allow all events.
+     */
+    static uint8_t toFilter(const String &keywords)
+    {
+        uint8_t mask = 0;
+        if (keywords.indexOf("get") > -1)
+            mask |= sse_event_type_get;
+        if (keywords.indexOf("put") > -1)
+            mask |= sse_event_type_put;
+        if (keywords.indexOf("patch") > -1)
+            mask |= sse_event_type_patch;
+        if (keywords.indexOf("keep-alive") > -1)
+            mask |= sse_event_type_keep_alive;
+        if (keywords.indexOf("cancel") > -1)
+            mask |= sse_event_type_cancel;
+        if (keywords.indexOf("auth_revoked") > -1)
+            mask |= sse_event_type_auth_revoked;
+        return mask;
+    }
+
+private:
+    enum field_type
+    {
+        field_name,
+        field_event,
+        field_data,
+        field_id,
+        field_retry,
+        field_ignore
+    };
+
+    uint8_t filter = 0;
+    field_type field = field_name;
+    char name[8];
+    uint8_t name_len = 0;
+    bool cr = false, value_begin = false, dropped = false, has_data = false, has_event = false, event_written = false, has_id = false, retry_invalid = false;
+    sse_event_type frame_type = sse_event_type_undefined;
+    size_t frame_event_p1 = 0, frame_event_p2 = 0, frame_data_p1 = 0, frame_data_p2 = 0;
+    sse_event_t ev;
+    uint32_t retry_buf = 0, retry_ms = 0;
+    String event_name, id_buf, last_id;
+
+    bool allowed(sse_event_type type) const { return filter == 0 || (filter & type) > 0; }
+
+    bool nameIs(const char *str) const { return name_len == strlen(str) && strncmp(name, str, name_len) == 0; }
+
+    void resetFrame()
+    {
+        field = field_name;
+        name_len = 0;
+        value_begin = false;
+        dropped = false;
+        has_data = false;
+        has_event = false;
+        event_written = false;
+        frame_type = sse_event_type_undefined;
+        frame_event_p1 = 0;
+        frame_event_p2 = 0;
+        frame_data_p1 = 0;
+        frame_data_p2 = 0;
+        event_name.remove(0, event_name.length());
+    }
+
+    void beginValue(String &out)
+    {
+        value_begin = true;
+
+        if (nameIs("event"))
+        {
+            field = field_event;
+            event_name.remove(0, event_name.length());
+        }
+        else if (nameIs("data"))
+        {
+            field = field_data;
+            if (!dropped)
+            {
+                if (!has_data)
+                {
+                    out += "data: ";
+                    frame_data_p1 = out.length();
+                }
+                else
+                    out += '\n';
+            }
+            has_data = true;
+        }
+        else if (nameIs("id"))
+        {
+            field = field_id;
+            id_buf.remove(0, id_buf.length());
+        }
+        else if (nameIs("retry"))
+        {
+            field = field_retry;
+            retry_buf = 0;
+            retry_invalid = false;
+        }
+        else // comment or unknown field
+            field = field_ignore;
+    }
+
+    parse_result endLine(String &out, bool initial)
+    {
+        // The blank line dispatches the frame.
+        if (field == field_name && name_len == 0)
+            return dispatch(out);
+
+        // The field without colon has the empty value.
+        if (field == field_name)
+            beginValue(out);
+
+        if (field == field_event)
+        {
+            has_event = true;
+            frame_type = SSEParser::getType(event_name.c_str(), event_name.length(), initial);
+            if (!allowed(frame_type))
+            {
+                dropped = true;
+                out.remove(0, out.length());
+            }
+            else if (!has_data)
+            {
+                // The event field comes first (as Firebase does), it was written before data.
+                out.remove(0, out.length());
+                out += "event: ";
+                frame_event_p1 = out.length();
+                out += event_name;
+                frame_event_p2 = out.length();
+                out += '\n';
+                event_written = true;
+            }
+            else
+                event_written = false;
+        }
+        else if (field == field_data)
+        {
+            if (!dropped)
+                frame_data_p2 = out.length();
+        }
+        else if (field == field_id)
+            has_id = true;
+        else if (field == field_retry)
+        {
+            if (!retry_invalid)
+                retry_ms = retry_buf;
+        }
+
+        field = field_name;
+        name_len = 0;
+        value_begin = false;
+        return parse_result_continue;
+    }
+
+    // Get the data and data path positions from the put and patch event data which is {"path":"<path>","data":<data>}.
+    void parseData(const char *s, size_t p1, size_t p2)
+    {
+        ev.data_p1 = p1;
+        ev.data_p2 = p2;
+
+        const size_t path_key_len = 9;
+        if (p2 - p1 < path_key_len || strncmp(s + p1, "{\"path\":\"", path_key_len) != 0)
+            return;
+
+        size_t i = p1 + path_key_len;
+        while (i < p2 && s[i] != '"')
+            i += s[i] == '\\' ? 2 : 1;
+
+        const size_t data_key_len = 8;
+        if (i >= p2 || p2 - i - 1 < data_key_len || strncmp(s + i + 1, ",\"data\":", data_key_len) != 0 || s[p2 - 1] != '}')
+            return;
+
+        ev.path_p1 = p1 + path_key_len;
+        ev.path_p2 = i;
+        ev.data_p1 = i + 1 + data_key_len;
+        ev.data_p2 = p2 - 1;
+    }
+
+    parse_result dispatch(String &out)
+    {
+        if (has_id)
+        {
+            last_id = id_buf;
+            has_id = false;
+        }
+
+        if (!has_event && !has_data)
+        {
+            resetFrame();
+            return parse_result_continue;
+        }
+
+        if (!has_event)
+            frame_type = sse_event_type_unknown;
+
+        ev = sse_event_t();
+        ev.type = frame_type;
+
+        if (dropped || !allowed(frame_type))
+        {
+            out.remove(0, out.length());
+            resetFrame();
+            return parse_result_dropped;
+        }
+
+        if (has_data)
+        {
+            out += '\n';
+            parseData(out.c_str(), frame_data_p1, frame_data_p2);
+        }
+
+        // The event field that comes after data is appended.
+        if (has_event && !event_written)
+        {
+            out += "event: ";
+            frame_event_p1 = out.length();
+            out += event_name;
+            frame_event_p2 = out.length();
+            out += '\n';
+        }
+
+        ev.event_p1 = frame_event_p1;
+        ev.event_p2 = frame_event_p2;
+
+        resetFrame();
+        return parse_result_event;
+    }
+};
+
+#endif
+
+#endif
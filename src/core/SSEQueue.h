@@ -0,0 +1,206 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CORE_SSE_QUEUE_H
+#define CORE_SSE_QUEUE_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/SSEParser.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The SSE mode (HTTP Streaming) events queue overflow policies.
+enum sse_queue_policy
+{
+    // Drop the oldest queued event.
+    sse_queue_policy_drop_oldest,
+    // Replace the oldest queued event which is superseded by the new event (the keep-alive event,
+    // or put and patch event at the same path or under the path of new put event),
+    // or drop the oldest queued event when nothing can be replaced.
+    sse_queue_policy_coalesce,
+    // Stop reading the stream until the queued event was taken.
+    sse_queue_policy_block
+};
+
+/**
+ * The bounded ring buffer of parsed SSE mode (HTTP Streaming) events.
+ */
+class SSEQueue
+{
+public:
+    struct item_t
+    {
+        String payload;
+        sse_event_t event;
+    };
+
+    SSEQueue() {}
+
+    /**
+     * Set the queue capacity and overflow policy.
+     *
+     * @param capacity The maximum number of queued events or 0 to disable the queue.
+     * @param policy The sse_queue_policy enum.
+     *
+     * The queued events and counters will be cleared.
+     */
+    void setCapacity(uint16_t capacity, sse_queue_policy policy)
+    {
+        items.clear();
+        items.resize(capacity);
+        this->policy = policy;
+        head = 0;
+        count = 0;
+        lost_count = 0;
+        coalesced_count = 0;
+    }
+
+    bool enabled() const { return items.size() > 0; }
+
+    size_t size() const { return count; }
+
+    bool full() const { return count == items.size(); }
+
+    // Returns true when the stream should not be read until the queued event was taken.
+    bool blocked() const { return enabled() && full() && policy == sse_queue_policy_block; }
+
+    // The number of events that were dropped because of queue overflow.
+    uint32_t lost() const { return lost_count; }
+
+    // The number of queued events that were replaced by the newer events.
+    uint32_t coalesced() const { return coalesced_count; }
+
+    /**
+     * Add the event to the queue.
+     *
+     * @param payload The event payload.
+     * @param event The event positions in the payload.
+     *
+     * When queue is full with the sse_queue_policy_block policy (the events that were already read),
+     * the oldest queued event will be dropped.
+     */
+    void push(const String &payload, const sse_event_t &event)
+    {
+        if (!enabled())
+            return;
+
+        if (full())
+        {
+            if (policy == sse_queue_policy_coalesce && coalesce(payload, event))
+                coalesced_count++;
+            else
+            {
+                pop();
+                lost_count++;
+            }
+        }
+
+        item_t &item = items[(head + count) % items.size()];
+        item.payload = payload;
+        item.event = event;
+        count++;
+    }
+
+    // Get the oldest queued event.
+    item_t *front() { return count ? &items[head] : nullptr; }
+
+    // Remove the oldest queued event.
+    void pop()
+    {
+        if (!count)
+            return;
+        items[head].payload.remove(0, items[head].payload.length());
+        head = (head + 1) % items.size();
+        count--;
+    }
+
+    // Remove all queued events, the capacity, policy and counters are kept.
+    void clear()
+    {
+        while (count)
+            pop();
+        head = 0;
+    }
+
+private:
+    std::vector<item_t> items;
+    sse_queue_policy policy = sse_queue_policy_drop_oldest;
+    size_t head = 0, count = 0;
+    uint32_t lost_count = 0, coalesced_count = 0;
+
+    // Check if the queued event at path is superseded by the put event at path.
+    bool underPath(const String &payload, const sse_event_t &event, const String &new_payload, const sse_event_t &new_event)
+    {
+        size_t len = new_event.path_p2 - new_event.path_p1;
+        const char *path = new_payload.c_str() + new_event.path_p1;
+
+        // The put event at root replaces everything.
+        if (len == 1 && path[0] == '/')
+            return true;
+
+        if (event.path_p2 - event.path_p1 < len || strncmp(payload.c_str() + event.path_p1, path, len) != 0)
+            return false;
+
+        return event.path_p2 - event.path_p1 == len || payload[event.path_p1 + len] == '/';
+    }
+
+    // Remove the oldest queued event that is superseded by the new event.
+    bool coalesce(const String &payload, const sse_event_t &event)
+    {
+        bool put = event.type == sse_event_type_put || event.type == sse_event_type_get;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            item_t &item = items[(head + i) % items.size()];
+            bool superseded = item.event.type == sse_event_type_keep_alive;
+
+            if (!superseded && put && event.path_p2 > event.path_p1 && item.event.path_p2 > item.event.path_p1 &&
+                (item.event.type == sse_event_type_get || item.event.type == sse_event_type_put || item.event.type == sse_event_type_patch))
+                superseded = underPath(item.payload, item.event, payload, event);
+
+            if (superseded)
+            {
+                // Shift the newer events to fill the removed one.
+                for (size_t j = i; j + 1 < count; j++)
+                {
+                    item_t &cur = items[(head + j) % items.size()];
+                    item_t &next = items[(head + j + 1) % items.size()];
+                    cur.payload = next.payload;
+                    cur.event = next.event;
+                }
+                item_t &last = items[(head + count - 1) % items.size()];
+                last.payload.remove(0, last.payload.length());
+                count--;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif
+
+#endif
@@ -70,6 +70,28 @@ private:
     bool ota = false;
 };
 
+// The maximum number of writes of transaction.
+#if !defined(FIREBASE_TRANSACTION_MAX_ATTEMPTS)
+#define FIREBASE_TRANSACTION_MAX_ATTEMPTS 10
+#endif
+
+// The milliseconds to wait before the second write of transaction, it is doubled for the next writes.
+#if !defined(FIREBASE_TRANSACTION_BACKOFF_MS)
+#define FIREBASE_TRANSACTION_BACKOFF_MS 100
+#endif
+
+// The maximum milliseconds to wait before the next write of transaction.
+#define FIREBASE_TRANSACTION_MAX_BACKOFF_MS 3000
+
+/**
+ * The transaction update function.
+ *
+ * @param current The current JSON value of node which is null when node does not exist.
+ * @param next The new JSON value of node.
+ * @return bool Returns true to write the new value or false to abort the transaction.
+ */
+typedef bool (*TransactionUpdateCallback)(const String &current, String &next);
+
 #endif
 
 #endif
\ No newline at end of file
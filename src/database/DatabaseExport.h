@@ -0,0 +1,250 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_EXPORT_H
+#define DATABASE_EXPORT_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/List.h"
+#include "./core/FileConfig.h"
+#include "./database/DatabaseIterator.h"
+
+#if defined(ENABLE_DATABASE) && defined(ENABLE_FS)
+
+/**
+ * The export of the child nodes of Realtime database node to the NDJSON file.
+ *
+ * The child nodes are read in pages ordered by key and written to file as one JSON object
+ * ({"<key>":<value>}) per line, then only two pages are kept in memory.
+ * The key of last written child node is the cursor that the export can be resumed after.
+ */
+class DatabaseExport
+{
+    friend class RealtimeDatabase;
+
+public:
+    /**
+     * @param pageSize The number of child nodes to read in one request.
+     */
+    explicit DatabaseExport(uint16_t pageSize = 50) : iterator(pageSize) {}
+    DatabaseExport(const DatabaseExport &) = delete;
+    DatabaseExport &operator=(const DatabaseExport &) = delete;
+
+    ~DatabaseExport()
+    {
+        if (evec_addr > 0)
+        {
+            std::vector<uint32_t> *eVec = reinterpret_cast<std::vector<uint32_t> *>(evec_addr);
+            List vec;
+            vec.addRemoveList(*eVec, reinterpret_cast<uint32_t>(this), false);
+        }
+    }
+
+    // The key of last child node that was written to file.
+    String cursor() const { return cursor_key; }
+
+    /**
+     * Set the key of child node that the export will be resumed after.
+     *
+     * @param key The child node key obtained from cursor().
+     */
+    void setCursor(const String &key) { cursor_key = key; }
+
+    // Returns true when all child nodes were written or the error occurred.
+    bool done() const { return finished; }
+
+    // Returns true when the page request or file write error occurred.
+    bool isError() { return err.isError() || err.code() != 0; }
+
+    // The error of page request or file write.
+    FirebaseError lastError() const { return err; }
+
+    // The number of child nodes that were written.
+    uint32_t count() const { return write_count; }
+
+    // The number of bytes that were written.
+    size_t length() const { return write_size; }
+
+private:
+    DatabaseIterator iterator;
+    file_config_data *file = nullptr;
+    String cursor_key;
+    uint32_t evec_addr = 0, write_count = 0;
+    size_t write_size = 0;
+    bool finished = false;
+    FirebaseError err;
+
+    void reset()
+    {
+        file = nullptr;
+        write_count = 0;
+        write_size = 0;
+        finished = false;
+        err = FirebaseError();
+    }
+
+    /**
+     * Prepare the file to resume the export.
+     *
+     * The incomplete last line (the write that was interrupted) is removed from the file and the cursor
+     * is read from the last complete line when it was not set.
+     *
+     * @return bool Returns false when the incomplete last line could not be removed.
+     */
+    bool resumeFile()
+    {
+        file->cb(file->file, file->filename.c_str(), file_mode_open_read);
+        if (!file->file)
+            return true;
+
+        // The length of the complete lines.
+        size_t size = file->file.size(), end = size > 0 ? lineStart(size) : 0;
+        if (end > 0 && cursor_key.length() == 0)
+        {
+            file->file.seek(lineStart(end - 1));
+            readKey();
+        }
+        file->file.close();
+
+        return end == size || truncate(end);
+    }
+
+    // Truncate the file to the length by copying it to the temporary file and back, the file callback can not truncate the file.
+    bool truncate(size_t len)
+    {
+        String temp = file->filename + ".tmp";
+        bool ret = copy(file->filename, temp, len) && copy(temp, file->filename, len);
+        FILEOBJ tfile;
+        file->cb(tfile, temp.c_str(), file_mode_remove);
+        return ret;
+    }
+
+    bool copy(const String &src, const String &dst, size_t len)
+    {
+        FILEOBJ in, out;
+        file->cb(in, src.c_str(), file_mode_open_read);
+        file->cb(out, dst.c_str(), file_mode_open_write);
+        bool ret = in && out;
+
+        uint8_t buf[64];
+        while (ret && len > 0)
+        {
+            size_t size = len < sizeof(buf) ? len : sizeof(buf);
+            ret = in.read(buf, size) == size && out.write(buf, size) == size;
+            len -= size;
+        }
+
+        if (in)
+            in.close();
+        if (out)
+            out.close();
+        return ret;
+    }
+
+    // Get the position after the line break that is before the position.
+    size_t lineStart(size_t pos)
+    {
+        uint8_t buf[32];
+        while (pos > 0)
+        {
+            size_t len = pos < sizeof(buf) ? pos : sizeof(buf);
+            file->file.seek(pos - len);
+            if (file->file.read(buf, len) != len)
+                return 0;
+            for (size_t i = len; i > 0; i--)
+            {
+                if (buf[i - 1] == '\n')
+                    return pos - len + i;
+            }
+            pos -= len;
+        }
+        return 0;
+    }
+
+    // Read the key of JSON object line {"<key>":<value>}.
+    void readKey()
+    {
+        if (file->file.read() != '{' || file->file.read() != '"')
+            return;
+
+        String key;
+        int c = 0;
+        while ((c = file->file.read()) > -1 && c != '"' && c != '\n')
+        {
+            key += (char)c;
+            if (c == '\\' && (c = file->file.read()) > -1)
+                key += (char)c;
+        }
+        if (c == '"')
+            cursor_key = key;
+    }
+
+    // Write the iterated child nodes to file, returns the error code or 0.
+    int write()
+    {
+        bool opened = false;
+        int code = 0;
+        while (iterator.next())
+        {
+            if (!opened)
+            {
+                file->cb(file->file, file->filename.c_str(), file_mode_open_append);
+                if (!file->file)
+                    return FIREBASE_ERROR_OPEN_FILE;
+                opened = true;
+            }
+
+            String key = iterator.key(), line;
+            String value = iterator.value();
+            line.reserve(key.length() + value.length() + 6);
+            // The key is kept as it is in the JSON payload.
+            line += "{\"";
+            line += key;
+            line += "\":";
+            line += value;
+            line += "}\n";
+
+            if (file->file.write(reinterpret_cast<const uint8_t *>(line.c_str()), line.length()) != line.length())
+            {
+                // The incomplete line will be removed when the export is resumed.
+                code = FIREBASE_ERROR_FILE_WRITE;
+                break;
+            }
+
+            cursor_key = key;
+            write_count++;
+            write_size += line.length();
+        }
+
+        if (opened)
+            file->file.close();
+        return code;
+    }
+};
+
+#endif
+
+#endif
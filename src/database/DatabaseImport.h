@@ -0,0 +1,358 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_IMPORT_H
+#define DATABASE_IMPORT_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/List.h"
+#include "./core/FileConfig.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+#if defined(ENABLE_DATABASE) && defined(ENABLE_FS)
+
+class AsyncClientClass;
+
+/**
+ * The import of JSON or NDJSON file to the Realtime database node.
+ *
+ * The file is read as the sequence of JSON objects e.g. one JSON object or one JSON object per line.
+ * The members of JSON objects are grouped into the size-bounded multi-path update (PATCH) requests
+ * which are sent concurrently with the async clients in the pool, then only the data of pending
+ * requests are kept in memory.
+ *
+ * The checkpoint is the file position before the first member that was not written successfully,
+ * the import can be resumed from the checkpoint.
+ */
+class DatabaseImport
+{
+    friend class RealtimeDatabase;
+
+public:
+    /**
+     * @param batchSize The maximum size of the request payload. The member that is larger than this size is sent in its own request.
+     * @param concurrency The maximum number of pending requests.
+     */
+    explicit DatabaseImport(size_t batchSize = 4096, uint8_t concurrency = 2)
+    {
+        batch_size = batchSize;
+        this->concurrency = concurrency > 0 ? concurrency : 1;
+    }
+
+    DatabaseImport(const DatabaseImport &) = delete;
+    DatabaseImport &operator=(const DatabaseImport &) = delete;
+
+    ~DatabaseImport()
+    {
+        clearBatches();
+        if (ivec_addr > 0)
+        {
+            std::vector<uint32_t> *iVec = reinterpret_cast<std::vector<uint32_t> *>(ivec_addr);
+            List vec;
+            vec.addRemoveList(*iVec, reinterpret_cast<uint32_t>(this), false);
+        }
+    }
+
+    /**
+     * Add the async client to the client pool.
+     *
+     * @param aClient The async client.
+     *
+     * Each request is sent with the least busy async client in the pool.
+     */
+    void addClient(AsyncClientClass &aClient)
+    {
+        for (size_t i = 0; i < clients.size(); i++)
+        {
+            if (clients[i] == &aClient)
+                return;
+        }
+        clients.push_back(&aClient);
+    }
+
+    /**
+     * Use the file to store the checkpoint.
+     *
+     * @param file The filesystem data (file_config_data) obtained from FileConfig class object.
+     *
+     * The checkpoint is saved when it was changed and is read when the import is resumed.
+     */
+    void setCheckpointFile(file_config_data &file) { checkpoint_file = file.cb && file.filename.length() ? &file : nullptr; }
+
+    // The file position that the import can be resumed from.
+    size_t checkpoint() const { return checkpoint_pos; }
+
+    /**
+     * Set the file position that the import will be resumed from.
+     *
+     * @param pos The file position obtained from checkpoint().
+     */
+    void setCheckpoint(size_t pos) { checkpoint_pos = pos; }
+
+    // Returns true when all members were written or the error occurred and the pending requests were finished.
+    bool done() const { return finished; }
+
+    // Returns true when the request or file read error occurred.
+    bool isError() { return err.isError() || err.code() != 0; }
+
+    // The error of request or file read.
+    FirebaseError lastError() const { return err; }
+
+    // The number of members that were written.
+    uint32_t count() const { return write_count; }
+
+private:
+    struct batch_t
+    {
+        AsyncClientClass *client = nullptr;
+        AsyncResult *result = nullptr;
+        uint32_t slot_addr = 0;
+        size_t start = 0, end = 0;
+        uint32_t members = 0;
+        bool failed = false;
+    };
+
+    std::vector<batch_t> batches;
+    std::vector<AsyncClientClass *> clients;
+    file_config_data *file = nullptr, *checkpoint_file = nullptr;
+    String path;
+    size_t batch_size = 4096, read_pos = 0, checkpoint_pos = 0;
+    uint32_t ivec_addr = 0, write_count = 0;
+    uint8_t concurrency = 2, depth = 0;
+    bool eof = false, finished = false;
+    FirebaseError err;
+
+    void reset()
+    {
+        clearBatches();
+        file = nullptr;
+        read_pos = 0;
+        write_count = 0;
+        depth = 0;
+        eof = false;
+        finished = false;
+        err = FirebaseError();
+    }
+
+    void clearBatches()
+    {
+        for (size_t i = 0; i < batches.size(); i++)
+            delete batches[i].result;
+        batches.clear();
+    }
+
+    // Start reading from checkpoint, the checkpoint other than the file beginning is inside the JSON object.
+    void resume()
+    {
+        read_pos = checkpoint_pos;
+        depth = read_pos > 0 ? 1 : 0;
+    }
+
+    void readCheckpoint()
+    {
+        if (!checkpoint_file)
+            return;
+        checkpoint_file->cb(checkpoint_file->file, checkpoint_file->filename.c_str(), file_mode_open_read);
+        if (!checkpoint_file->file)
+            return;
+        size_t pos = 0;
+        int c = 0;
+        while ((c = checkpoint_file->file.read()) >= '0' && c <= '9')
+            pos = pos * 10 + c - '0';
+        checkpoint_file->file.close();
+        checkpoint_pos = pos;
+    }
+
+    void saveCheckpoint()
+    {
+        if (!checkpoint_file)
+            return;
+        checkpoint_file->cb(checkpoint_file->file, checkpoint_file->filename.c_str(), file_mode_open_write);
+        if (checkpoint_file->file)
+        {
+            checkpoint_file->file.print(checkpoint_pos);
+            checkpoint_file->file.close();
+        }
+    }
+
+    // Remove the successfully written batches in file order and move the checkpoint.
+    void updateCheckpoint()
+    {
+        while (batches.size() && !batches[0].result && !batches[0].failed)
+        {
+            write_count += batches[0].members;
+            batches.erase(batches.begin());
+        }
+        size_t pos = batches.size() ? batches[0].start : read_pos;
+        if (pos != checkpoint_pos)
+        {
+            checkpoint_pos = pos;
+            saveCheckpoint();
+        }
+    }
+
+    /**
+     * Read the members of JSON objects into the request payload.
+     *
+     * @param batch The batch to keep the file positions of the first member and after the last member.
+     * @param payload The JSON object of members.
+     * @return int The error code or 0.
+     */
+    int readBatch(batch_t &batch, String &payload)
+    {
+        file->cb(file->file, file->filename.c_str(), file_mode_open_read);
+        if (!file->file)
+            return FIREBASE_ERROR_OPEN_FILE;
+
+        size_t size = file->file.size(), pos = read_pos, member_start = 0;
+        int code = 0;
+        String member;
+        bool in_member = false, in_str = false, esc = false;
+        uint8_t level = depth, buf[64];
+        size_t len = 0, index = 0;
+
+        payload.remove(0, payload.length());
+        batch.members = 0;
+
+        // All members were read.
+        if (pos >= size)
+        {
+            file->file.close();
+            eof = true;
+            return 0;
+        }
+
+        file->file.seek(pos);
+
+        while (pos < size)
+        {
+            if (index == len)
+            {
+                len = file->file.read(buf, pos + sizeof(buf) > size ? size - pos : sizeof(buf));
+                index = 0;
+                if (len == 0)
+                {
+                    code = FIREBASE_ERROR_FILE_READ;
+                    break;
+                }
+            }
+
+            char c = buf[index];
+            bool end = false;
+
+            if (!in_member)
+            {
+                if (c == '{' && level == 0)
+                    level = 1;
+                else if (c == '}' && level == 1)
+                    level = 0;
+                else if (c == '"' && level == 1)
+                {
+                    in_member = true;
+                    in_str = true;
+                    member_start = pos;
+                    member += c;
+                }
+                else if (!(c == ',' && level == 1) && c != ' ' && c != '\t' && c != '\r' && c != '\n')
+                {
+                    code = FIREBASE_ERROR_INVALID_JSON_DATA;
+                    break;
+                }
+            }
+            else if (in_str)
+            {
+                member += c;
+                if (esc)
+                    esc = false;
+                else if (c == '\\')
+                    esc = true;
+                else if (c == '"')
+                    in_str = false;
+            }
+            else if ((c == ',' || c == '}') && level == 1)
+                end = true; // The member ends before this character which is read again in the next batch.
+            else
+            {
+                member += c;
+                if (c == '"')
+                    in_str = true;
+                else if (c == '{' || c == '[')
+                    level++;
+                else if (c == '}' || c == ']')
+                    level--;
+            }
+
+            if (end)
+            {
+                // Keep this member for the next batch.
+                if (batch.members > 0 && payload.length() + member.length() + 2 > batch_size)
+                {
+                    pos = member_start;
+                    break;
+                }
+
+                if (batch.members == 0)
+                    batch.start = member_start;
+                payload += batch.members ? ',' : '{';
+                payload += member;
+                batch.members++;
+                member.remove(0, member.length());
+                in_member = false;
+
+                // The batch is full, the position is kept at the end of member.
+                if (payload.length() + 1 >= batch_size)
+                    break;
+
+                if (c == '}')
+                    level = 0;
+            }
+
+            index++;
+            pos++;
+        }
+
+        file->file.close();
+
+        if (code == 0 && pos == size && (in_member || level > 0))
+            code = FIREBASE_ERROR_INVALID_JSON_DATA;
+
+        if (code < 0)
+            return code;
+
+        if (batch.members > 0)
+            payload += '}';
+
+        read_pos = pos;
+        depth = level;
+        batch.end = pos;
+        eof = pos == size;
+        return 0;
+    }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_ITERATOR_H
+#define DATABASE_ITERATOR_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/List.h"
+#include "./core/JsonReader.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+#if defined(ENABLE_DATABASE)
+
+class AsyncClientClass;
+
+/**
+ * The iterator of the child nodes of Realtime database node which are read in pages ordered by key.
+ *
+ * The next page is requested from RealtimeDatabase::loop while the current page is iterated,
+ * then only the current page and the next page are kept in memory.
+ */
+class DatabaseIterator
+{
+    friend class RealtimeDatabase;
+
+public:
+    /**
+     * @param pageSize The number of child nodes to read in one request.
+     */
+    explicit DatabaseIterator(uint16_t pageSize = 50) { page_size = pageSize > 0 ? pageSize : 1; }
+    DatabaseIterator(const DatabaseIterator &) = delete;
+    DatabaseIterator &operator=(const DatabaseIterator &) = delete;
+
+    ~DatabaseIterator()
+    {
+        delete result;
+        if (ivec_addr > 0)
+        {
+            std::vector<uint32_t> *iVec = reinterpret_cast<std::vector<uint32_t> *>(ivec_addr);
+            List vec;
+            vec.addRemoveList(*iVec, reinterpret_cast<uint32_t>(this), false);
+        }
+    }
+
+    /**
+     * Move to the next child node.
+     *
+     * @return bool Returns true if the child node is available, false when the next page was not read yet or all child nodes were iterated.
+     */
+    bool next()
+    {
+        if (index + 1 < (int)order.size())
+        {
+            index++;
+            return true;
+        }
+
+        if (!next_ready)
+            return false;
+
+        // Take the next page, the page after it will be requested in RealtimeDatabase::loop.
+        current = next_page;
+        page_start = next_start;
+        next_page.remove(0, next_page.length());
+        next_ready = false;
+        setPage();
+
+        if (index + 1 < (int)order.size())
+        {
+            index++;
+            return true;
+        }
+        return false;
+    }
+
+    // The key of current child node.
+    String key() const { return index > -1 ? substring(current, order[index].key, order[index].key_len) : String(); }
+
+    // The JSON value of current child node.
+    String value() const { return index > -1 ? substring(current, order[index].value, order[index].value_len) : String(); }
+
+    // Returns true when all child nodes were iterated.
+    bool done() const { return last_page && !pending() && !next_ready && index + 1 >= (int)order.size(); }
+
+    // Returns true when the error occurred, the child nodes that were read can still be iterated.
+    bool isError() { return err.isError() || err.code() != 0; }
+
+    // The error of page request.
+    FirebaseError lastError() const { return err; }
+
+    // The number of child nodes that were read.
+    uint32_t count() const { return read_count; }
+
+private:
+    uint16_t page_size = 50;
+    uint32_t ivec_addr = 0, slot_addr = 0, read_count = 0;
+    AsyncClientClass *client = nullptr;
+    AsyncResult *result = nullptr;
+    // The last key of received pages, the startAt key of current page and next page.
+    String path, last_key, page_start, next_start;
+    String current, next_page;
+    int index = -1;
+    bool next_ready = false, last_page = false;
+    FirebaseError err;
+
+    // The positions of key and raw JSON value of child node in the page payload.
+    struct child_t
+    {
+        uint32_t key = 0, key_len = 0, value = 0, value_len = 0;
+        // The integer key and its value.
+        bool num = false;
+        int32_t num_val = 0;
+    };
+    std::vector<child_t> order;
+
+    bool pending() const { return result != nullptr; }
+
+    void reset()
+    {
+        delete result;
+        result = nullptr;
+        slot_addr = 0;
+        read_count = 0;
+        last_key.remove(0, last_key.length());
+        page_start.remove(0, page_start.length());
+        next_start.remove(0, next_start.length());
+        current.remove(0, current.length());
+        next_page.remove(0, next_page.length());
+        order.clear();
+        index = -1;
+        next_ready = false;
+        last_page = false;
+        err = FirebaseError();
+    }
+
+    // The number of child nodes to request, the first child node of the next pages is the last child node of previous page.
+    uint16_t limit() const { return last_key.length() ? page_size + 1 : page_size; }
+
+    // Keep the received page as the next page.
+    void setNextPage(const String &payload)
+    {
+        std::vector<child_t> list;
+        children(payload, list);
+        last_page = list.size() < limit();
+
+        size_t max = 0;
+        for (size_t i = 1; i < list.size(); i++)
+        {
+            if (keyLess(payload, list[max], list[i]))
+                max = i;
+        }
+
+        next_start = last_key;
+        if (list.size() > 0)
+        {
+            last_key = substring(payload, list[max].key, list[max].key_len);
+            next_page = payload;
+            next_ready = true;
+        }
+    }
+
+    // Sort the child nodes of current page by key, the startAt child node that was in the previous page is skipped.
+    void setPage()
+    {
+        std::vector<child_t> list;
+        children(current, list);
+        order.clear();
+        index = -1;
+
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            if (page_start.length() && list[i].key_len == page_start.length() && strncmp(current.c_str() + list[i].key, page_start.c_str(), page_start.length()) == 0)
+                continue;
+
+            // The child nodes are usually received in key order, then no child node is moved.
+            size_t j = order.size();
+            order.push_back(list[i]);
+            while (j > 0 && keyLess(current, list[i], order[j - 1]))
+            {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = list[i];
+        }
+        read_count += order.size();
+    }
+
+    // Get the child nodes of the object in a single pass.
+    static void children(const String &payload, std::vector<child_t> &list)
+    {
+        JsonReader reader;
+        if (!reader.parse(payload) || reader.tape[0].type != json_value_type_object)
+            return;
+
+        for (uint32_t i = reader.firstChild(0); i < reader.tape[0].next; i = reader.nextChild(i, json_value_type_object))
+        {
+            child_t child;
+            child.key = reader.tape[i].p1;
+            child.key_len = reader.tape[i].p2 - reader.tape[i].p1;
+
+            // The string value includes its quotes.
+            const JsonReader::token_t &tok = reader.tape[i + 1];
+            uint32_t q = tok.type == json_value_type_string ? 1 : 0;
+            child.value = tok.p1 - q;
+            child.value_len = tok.p2 - tok.p1 + 2 * q;
+
+            child.num = toInt(payload.c_str() + child.key, child.key_len, child.num_val);
+            list.push_back(child);
+        }
+    }
+
+    // The order by key, the integer keys are first and ordered by value, then the string keys in lexicographical order.
+    static bool keyLess(const String &payload, const child_t &a, const child_t &b)
+    {
+        if (a.num != b.num)
+            return a.num;
+        if (a.num)
+            return a.num_val < b.num_val;
+        int cmp = memcmp(payload.c_str() + a.key, payload.c_str() + b.key, a.key_len < b.key_len ? a.key_len : b.key_len);
+        return cmp < 0 || (cmp == 0 && a.key_len < b.key_len);
+    }
+
+    // The integer key is the 32-bit signed integer, other keys are the string keys.
+    static bool toInt(const char *s, size_t len, int32_t &out)
+    {
+        size_t i = len > 0 && s[0] == '-' ? 1 : 0;
+        if (i == len || len - i > 10)
+            return false;
+
+        int64_t val = 0;
+        for (; i < len; i++)
+        {
+            if (s[i] < '0' || s[i] > '9')
+                return false;
+            val = val * 10 + (s[i] - '0');
+        }
+
+        if (s[0] == '-')
+            val = -val;
+        if (val < INT32_MIN || val > INT32_MAX)
+            return false;
+        out = (int32_t)val;
+        return true;
+    }
+
+    static String substring(const String &s, uint32_t pos, uint32_t len)
+    {
+        String out;
+        out.reserve(len);
+        for (uint32_t i = 0; i < len; i++)
+            out += s[pos + i];
+        return out;
+    }
+};
+
+#endif
+
+#endif
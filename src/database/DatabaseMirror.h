@@ -0,0 +1,431 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_MIRROR_H
+#define DATABASE_MIRROR_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/JsonReader.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The maximum depth of JSON data to parse, the Realtime database supports up to 32 levels.
+#define FIREBASE_MIRROR_MAX_DEPTH 32
+
+typedef void (*DatabaseMirrorCallback)(const String &path);
+
+/**
+ * The local in-memory copy of the Realtime database node which is maintained from the SSE mode (HTTP Streaming) events.
+ *
+ * The put and patch events are applied at their data paths, the data at any path under the Stream path
+ * can be read locally without the network request.
+ */
+class DatabaseMirror
+{
+public:
+    DatabaseMirror() {}
+    DatabaseMirror(const DatabaseMirror &) = delete;
+    DatabaseMirror &operator=(const DatabaseMirror &) = delete;
+
+    ~DatabaseMirror() { clear(); }
+
+    /**
+     * Apply the SSE mode (HTTP Streaming) event.
+     *
+     * @param aResult The AsyncResult from SSE mode (HTTP Streaming) task.
+     * @return bool Returns true if the put or patch event was applied.
+     *
+     * This should be called from the Stream result callback or when the Stream result is available.
+     */
+    bool apply(AsyncResult &aResult)
+    {
+        RealtimeDatabaseResult &RTDB = aResult.to<RealtimeDatabaseResult>();
+        if (!RTDB.isStream())
+            return false;
+
+        sse_event_type type = RTDB.eventType();
+        if (type == sse_event_type_get || type == sse_event_type_put)
+            return set(RTDB.dataPath(), RTDB.data());
+        else if (type == sse_event_type_patch)
+            return update(RTDB.dataPath(), RTDB.data());
+        return false;
+    }
+
+    /**
+     * Replace the data at the path.
+     *
+     * @param path The relative path to the Stream path.
+     * @param json The JSON data, the null removes the data at the path.
+     * @return bool Returns true if the JSON data is valid.
+     */
+    bool set(const String &path, const String &json)
+    {
+        node_t *value = new node_t();
+        if (!parse(json, value))
+        {
+            deleteNode(value);
+            return false;
+        }
+
+        std::vector<String> keys;
+        splitPath(path, keys);
+        setNode(keys, value);
+
+        if (keys.size() == 0)
+            synced = true;
+
+        notify(keys);
+        return true;
+    }
+
+    /**
+     * Update the children of the data at the path.
+     *
+     * @param path The relative path to the Stream path.
+     * @param json The JSON object of the children (or relative paths) and their data.
+     * @return bool Returns true if the JSON data is the valid JSON object.
+     */
+    bool update(const String &path, const String &json)
+    {
+        node_t *value = new node_t();
+        // The null children are kept to remove the data at their paths.
+        if (!parse(json, value, true) || value->value.length() || value->array)
+        {
+            deleteNode(value);
+            return false;
+        }
+
+        std::vector<String> keys;
+        splitPath(path, keys);
+        size_t depth = keys.size();
+
+        for (size_t i = 0; i < value->children.size(); i++)
+        {
+            keys.resize(depth);
+            splitPath(value->children[i]->key, keys);
+            setNode(keys, value->children[i]);
+        }
+
+        value->children.clear();
+        deleteNode(value);
+
+        keys.resize(depth);
+        notify(keys);
+        return true;
+    }
+
+    /**
+     * Check if the data at the path exists.
+     *
+     * @param path The relative path to the Stream path.
+     * @return bool Returns true if the data exists.
+     */
+    bool existed(const String &path) { return findNode(path) != nullptr; }
+
+    /**
+     * Get the JSON data at the path.
+     *
+     * @param path The relative path to the Stream path.
+     * @return String The JSON data or null if data does not exist.
+     */
+    String get(const String &path)
+    {
+        String out;
+        node_t *node = findNode(path);
+        if (node)
+            toJSON(node, out);
+        else
+            out = "null";
+        return out;
+    }
+
+    /**
+     * Convert the data at the path to any type of values.
+     *
+     * @param path The relative path to the Stream path.
+     * @return T The T type value e.g. boolean, integer, float, double and string.
+     */
+    template <typename T>
+    T to(const String &path) { return vcon.to<T>(get(path).c_str()); }
+
+    /**
+     * Get the type of data at the path.
+     *
+     * @param path The relative path to the Stream path.
+     * @return realtime_database_data_type The realtime_database_data_type enum represents the type of data.
+     */
+    realtime_database_data_type type(const String &path) { return vcon.getType(get(path).c_str()); }
+
+    /**
+     * Check if the data at the Stream path was received.
+     *
+     * @return bool Returns true if the first put event at the Stream path was applied.
+     */
+    bool isSynced() const { return synced; }
+
+    /**
+     * Set the callback function which called when the data was changed.
+     *
+     * @param cb The DatabaseMirrorCallback function that accepts the relative path of data that has been changed.
+     */
+    void setCallback(DatabaseMirrorCallback cb) { this->cb = cb; }
+
+    /**
+     * Remove all data.
+     */
+    void clear()
+    {
+        clearNode(&root);
+        synced = false;
+    }
+
+private:
+    struct node_t
+    {
+        String key;
+        // The JSON value of leaf node.
+        String value;
+        bool array = false;
+        std::vector<node_t *> children;
+    };
+
+    node_t root;
+    bool synced = false;
+    DatabaseMirrorCallback cb = NULL;
+    ValueConverter vcon;
+
+    void splitPath(const String &path, std::vector<String> &keys)
+    {
+        int p1 = 0;
+        int len = path.length();
+        while (p1 < len)
+        {
+            int p2 = path.indexOf('/', p1);
+            if (p2 == -1)
+                p2 = len;
+            if (p2 > p1)
+                keys.push_back(path.substring(p1, p2));
+            p1 = p2 + 1;
+        }
+    }
+
+    void notify(const std::vector<String> &keys)
+    {
+        if (!cb)
+            return;
+
+        String path;
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            path += '/';
+            path += keys[i];
+        }
+
+        if (path.length() == 0)
+            path = "/";
+
+        cb(path);
+    }
+
+    void clearNode(node_t *node)
+    {
+        for (size_t i = 0; i < node->children.size(); i++)
+            deleteNode(node->children[i]);
+        node->children.clear();
+        node->value.remove(0, node->value.length());
+        node->array = false;
+    }
+
+    void deleteNode(node_t *node)
+    {
+        clearNode(node);
+        delete node;
+    }
+
+    bool isEmpty(const node_t *node) const { return node->children.size() == 0 && node->value.length() == 0; }
+
+    node_t *findChild(node_t *node, const String &key, int &index)
+    {
+        for (size_t i = 0; i < node->children.size(); i++)
+        {
+            if (node->children[i]->key == key)
+            {
+                index = i;
+                return node->children[i];
+            }
+        }
+        index = -1;
+        return nullptr;
+    }
+
+    node_t *findNode(const String &path)
+    {
+        std::vector<String> keys;
+        splitPath(path, keys);
+
+        node_t *node = &root;
+        int index = 0;
+        for (size_t i = 0; i < keys.size() && node; i++)
+            node = findChild(node, keys[i], index);
+
+        return node && !isEmpty(node) ? node : nullptr;
+    }
+
+    // Set the value node (the ownership was taken) at the path keys, the empty value removes the node.
+    void setNode(const std::vector<String> &keys, node_t *value)
+    {
+        std::vector<node_t *> parents;
+        node_t *node = &root;
+        int index = 0;
+
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            parents.push_back(node);
+            node_t *child = findChild(node, keys[i], index);
+            if (!child)
+            {
+                if (isEmpty(value))
+                {
+                    deleteNode(value);
+                    return;
+                }
+
+                child = new node_t();
+                child->key = keys[i];
+                // Assign the value to the object node.
+                if (node->value.length())
+                    node->value.remove(0, node->value.length());
+                node->children.push_back(child);
+            }
+            else if (node->value.length())
+                node->value.remove(0, node->value.length());
+            node = child;
+        }
+
+        clearNode(node);
+        node->value = value->value;
+        node->array = value->array;
+        node->children = value->children;
+        value->children.clear();
+        delete value;
+
+        // Remove the empty nodes.
+        for (int i = parents.size() - 1; i >= 0 && isEmpty(node); i--)
+        {
+            findChild(parents[i], node->key, index);
+            deleteNode(node);
+            parents[i]->children.erase(parents[i]->children.begin() + index);
+            node = parents[i];
+        }
+    }
+
+    // Parse the JSON value, the null value will be the empty node.
+    bool parse(const String &json, node_t *node, bool keepNullChildren = false)
+    {
+        JsonReader reader;
+        return reader.parse(json) && addNode(reader, 0, node, 0, keepNullChildren);
+    }
+
+    // Build the node from the parsed value at the tape index.
+    bool addNode(const JsonReader &reader, uint32_t index, node_t *node, int depth, bool keepNullChildren = false)
+    {
+        if (depth > FIREBASE_MIRROR_MAX_DEPTH)
+            return false;
+
+        const JsonReader::token_t &tok = reader.tape[index];
+        if (tok.type == json_value_type_object || tok.type == json_value_type_array)
+        {
+            node->array = tok.type == json_value_type_array;
+            size_t n = 0;
+            for (uint32_t i = reader.firstChild(index); i < tok.next; i = reader.nextChild(i, tok.type))
+            {
+                node_t *child = new node_t();
+                uint32_t value = i;
+                if (node->array)
+                    child->key = String(n++);
+                else
+                {
+                    reader.assign(child->key, reader.src + reader.tape[i].p1, reader.tape[i].p2 - reader.tape[i].p1);
+                    value = i + 1;
+                }
+
+                if (!addNode(reader, value, child, depth + 1))
+                {
+                    deleteNode(child);
+                    return false;
+                }
+
+                if (isEmpty(child) && !keepNullChildren)
+                    deleteNode(child);
+                else
+                    node->children.push_back(child);
+            }
+            return true;
+        }
+
+        if (tok.type == json_value_type_null)
+            return true;
+
+        // The string value includes its quotes.
+        size_t q = tok.type == json_value_type_string ? 1 : 0;
+        reader.assign(node->value, reader.src + tok.p1 - q, tok.p2 - tok.p1 + 2 * q);
+        return true;
+    }
+
+    void toJSON(const node_t *node, String &out)
+    {
+        if (node->value.length())
+        {
+            out += node->value;
+            return;
+        }
+
+        // The array which elements were removed will be the object.
+        bool array = node->array;
+        for (size_t i = 0; array && i < node->children.size(); i++)
+            array = node->children[i]->key == String(i);
+
+        out += array ? '[' : '{';
+        for (size_t i = 0; i < node->children.size(); i++)
+        {
+            if (i > 0)
+                out += ',';
+            if (!array)
+            {
+                out += '"';
+                out += node->children[i]->key;
+                out += "\":";
+            }
+            toJSON(node->children[i], out);
+        }
+        out += array ? ']' : '}';
+    }
+};
+
+#endif
+
+#endif
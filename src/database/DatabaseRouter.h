@@ -0,0 +1,302 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_ROUTER_H
+#define DATABASE_ROUTER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./database/RealtimeDatabase.h"
+
+#if defined(ENABLE_DATABASE)
+
+/**
+ * The route callback function that maps the node path to the database (shard) index.
+ *
+ * @param path The node path.
+ * @param shards The number of databases.
+ * @return uint8_t The database index (0 to shards - 1).
+ */
+typedef uint8_t (*DatabaseRouteCallback)(const String &path, uint8_t shards);
+
+/**
+ * The router that maps the node paths to the Realtime Database instances (shards).
+ *
+ * Each shard has its own RealtimeDatabase object and the pool of async clients, all shards
+ * are authenticated with the same FirebaseApp. By default, the path is routed by the
+ * hash of its first segment.
+ *
+ * The router owns its RealtimeDatabase objects then it cannot be copied.
+ */
+class DatabaseRouter
+{
+public:
+    DatabaseRouter() {}
+    DatabaseRouter(const DatabaseRouter &) = delete;
+    DatabaseRouter &operator=(const DatabaseRouter &) = delete;
+
+    ~DatabaseRouter()
+    {
+        for (size_t i = 0; i < shard_list.size(); i++)
+            delete shard_list[i].db;
+        shard_list.clear();
+    }
+
+    /**
+     * Add the database (shard).
+     *
+     * @param url The database URL.
+     * @return uint8_t The index of added database.
+     */
+    uint8_t addShard(const String &url)
+    {
+        shard_t shard;
+        shard.db = new RealtimeDatabase(url);
+        if (app)
+            app->getApp<RealtimeDatabase>(*shard.db);
+        shard_list.push_back(shard);
+        return shard_list.size() - 1;
+    }
+
+    /**
+     * Add the async client to the client pool of database.
+     *
+     * @param shard The database index.
+     * @param aClient The async client.
+     *
+     * The async client should not be shared between databases.
+     * The FIREBASE_ERROR_DATABASE_ROUTE error is set when the database index is out of range.
+     */
+    void addClient(uint8_t shard, AsyncClientClass &aClient)
+    {
+        if (!setRouteError(shard < shard_list.size()))
+            shard_list[shard].clients.push_back(&aClient);
+    }
+
+    /**
+     * Apply the FirebaseApp authentication to all databases.
+     *
+     * @param app The FirebaseApp object.
+     *
+     * The databases that are added later will be applied with this app too.
+     */
+    void setApp(FirebaseApp &app)
+    {
+        this->app = &app;
+        for (size_t i = 0; i < shard_list.size(); i++)
+            app.getApp<RealtimeDatabase>(*shard_list[i].db);
+    }
+
+    /**
+     * Set the route callback function.
+     *
+     * @param cb The DatabaseRouteCallback function or NULL to use the default hash route.
+     */
+    void setRoute(DatabaseRouteCallback cb) { route_cb = cb; }
+
+    /**
+     * Get the database index of path.
+     *
+     * @param path The node path.
+     * @return uint8_t The database index.
+     */
+    uint8_t route(const String &path) const
+    {
+        uint8_t index = select(path);
+        return index < shard_list.size() ? index : 0;
+    }
+
+    /**
+     * Get the database of path.
+     *
+     * @param path The node path.
+     * @return RealtimeDatabase & The RealtimeDatabase object.
+     *
+     * The FIREBASE_ERROR_DATABASE_ROUTE error is set and the unused RealtimeDatabase object (without URL)
+     * is returned when no database was added or the route callback returns the index that is out of range.
+     */
+    RealtimeDatabase &database(const String &path) { return shard(select(path)); }
+
+    /**
+     * Get the database by index.
+     *
+     * @param index The database index.
+     * @return RealtimeDatabase & The RealtimeDatabase object.
+     *
+     * The FIREBASE_ERROR_DATABASE_ROUTE error is set and the unused RealtimeDatabase object (without URL)
+     * is returned when the index is out of range.
+     */
+    RealtimeDatabase &shard(uint8_t index) { return setRouteError(index < shard_list.size()) ? empty_db : *shard_list[index].db; }
+
+    /**
+     * Get the least busy async client from the client pool of database that the path is routed to.
+     *
+     * @param path The node path.
+     * @return AsyncClientClass & The async client.
+     *
+     * The FIREBASE_ERROR_DATABASE_ROUTE error is set and the unused async client (without network client)
+     * is returned when the route is out of range or the client pool of database is empty.
+     */
+    AsyncClientClass &client(const String &path)
+    {
+        uint8_t index = select(path);
+        AsyncClientClass *aClient = nullptr;
+        if (index < shard_list.size())
+        {
+            std::vector<AsyncClientClass *> &clients = shard_list[index].clients;
+            for (size_t i = 0; i < clients.size(); i++)
+            {
+                if (!aClient || clients[i]->taskCount() < aClient->taskCount())
+                    aClient = clients[i];
+            }
+        }
+        return setRouteError(aClient != nullptr) ? empty_client : *aClient;
+    }
+
+    // Returns true when the last addClient, database, shard or client call failed.
+    bool isError() { return err.isError() || err.code() != 0; }
+
+    // The error of the last addClient, database, shard or client call.
+    FirebaseError lastError() const { return err; }
+
+    // The number of databases.
+    uint8_t shards() const { return shard_list.size(); }
+
+    /**
+     * Get the number of completed requests of database.
+     *
+     * @param index The database index.
+     * @return uint32_t The number of requests of all async clients in the pool.
+     */
+    uint32_t requests(uint8_t index) const
+    {
+        uint32_t count = 0;
+        if (index < shard_list.size())
+        {
+            for (size_t i = 0; i < shard_list[index].clients.size(); i++)
+                count += shard_list[index].clients[i]->requestCount();
+        }
+        return count;
+    }
+
+    /**
+     * Get the number of failed requests of database.
+     *
+     * @param index The database index.
+     * @return uint32_t The number of failed requests of all async clients in the pool.
+     */
+    uint32_t errors(uint8_t index) const
+    {
+        uint32_t count = 0;
+        if (index < shard_list.size())
+        {
+            for (size_t i = 0; i < shard_list[index].clients.size(); i++)
+                count += shard_list[index].clients[i]->errorCount();
+        }
+        return count;
+    }
+
+    /**
+     * Get the average request latency of database.
+     *
+     * @param index The database index.
+     * @return uint32_t The average latency in milliseconds of all async clients in the pool.
+     */
+    uint32_t latency(uint8_t index) const
+    {
+        uint64_t total = 0;
+        uint32_t count = 0;
+        if (index < shard_list.size())
+        {
+            for (size_t i = 0; i < shard_list[index].clients.size(); i++)
+            {
+                AsyncClientClass *aClient = shard_list[index].clients[i];
+                total += (uint64_t)aClient->averageLatency() * aClient->requestCount();
+                count += aClient->requestCount();
+            }
+        }
+        return count ? total / count : 0;
+    }
+
+    /**
+     * Perform the async task repeatedly of all databases.
+     * Should be placed in the main loop function.
+     */
+    void loop()
+    {
+        for (size_t i = 0; i < shard_list.size(); i++)
+            shard_list[i].db->loop();
+    }
+
+private:
+    struct shard_t
+    {
+        RealtimeDatabase *db = nullptr;
+        std::vector<AsyncClientClass *> clients;
+    };
+
+    std::vector<shard_t> shard_list;
+    FirebaseApp *app = nullptr;
+    DatabaseRouteCallback route_cb = NULL;
+    RealtimeDatabase empty_db;
+    AsyncClientClass empty_client;
+    FirebaseError err;
+
+    // The database index from the route callback or hash, it can be out of range.
+    uint8_t select(const String &path) const
+    {
+        if (shard_list.size() == 0)
+            return 0;
+        return route_cb ? route_cb(path, shard_list.size()) : hash(path) % shard_list.size();
+    }
+
+    // Set or clear the route error, returns true when the error was set.
+    bool setRouteError(bool valid)
+    {
+        err.clearError();
+        if (!valid)
+            err.setClientError(FIREBASE_ERROR_DATABASE_ROUTE);
+        return !valid;
+    }
+
+    // The FNV-1a hash of the first path segment.
+    static uint32_t hash(const String &path)
+    {
+        uint32_t h = 2166136261UL;
+        size_t i = 0;
+        while (i < path.length() && path[i] == '/')
+            i++;
+        for (; i < path.length() && path[i] != '/'; i++)
+        {
+            h ^= (uint8_t)path[i];
+            h *= 16777619UL;
+        }
+        return h;
+    }
+};
+
+#endif
+
+#endif
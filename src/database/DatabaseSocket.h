@@ -0,0 +1,851 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_SOCKET_H
+#define DATABASE_SOCKET_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/FirebaseApp.h"
+#include "./core/Base64.h"
+#include "./core/JsonReader.h"
+#include "./core/PathUtil.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The maximum size of WebSocket message, the larger message is split into multiple messages.
+#if !defined(FIREBASE_SOCKET_FRAME_SIZE)
+#define FIREBASE_SOCKET_FRAME_SIZE 16384
+#endif
+
+// The keep-alive interval in milliseconds.
+#if !defined(FIREBASE_SOCKET_KEEP_ALIVE_MS)
+#define FIREBASE_SOCKET_KEEP_ALIVE_MS 45 * 1000
+#endif
+
+// The maximum reconnect delay in milliseconds.
+#if !defined(FIREBASE_SOCKET_MAX_RETRY_MS)
+#define FIREBASE_SOCKET_MAX_RETRY_MS 30 * 1000
+#endif
+
+using namespace firebase;
+
+/**
+ * The Realtime database client that uses the WebSocket wire protocol (v5) of Firebase SDKs.
+ *
+ * The listens, writes and their acknowledgements share one persistent connection of the network client,
+ * the writes are sent as the WebSocket messages without HTTP request headers. The listens and the writes
+ * that were not acknowledged are sent again when the connection was restored.
+ */
+class DatabaseSocket : public RTDBResultBase
+{
+    friend class FirebaseApp;
+    friend class AppBase;
+
+public:
+    /**
+     * @param url The database URL e.g. https://xxx.firebaseio.com, ws://localhost:9000?ns=xxx for the local server.
+     */
+    explicit DatabaseSocket(const String &url = "") { this->url(url); }
+    DatabaseSocket(const DatabaseSocket &) = delete;
+    DatabaseSocket &operator=(const DatabaseSocket &) = delete;
+
+    ~DatabaseSocket()
+    {
+        disconnect();
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            delete requests[i]->result;
+            delete requests[i];
+        }
+        requests.clear();
+    }
+
+    /**
+     * Set the database URL.
+     *
+     * @param url The database URL e.g. https://xxx.firebaseio.com, ws://localhost:9000?ns=xxx for the local server.
+     *
+     * The namespace is the first label of host name when the ns query parameter was not set.
+     */
+    void url(const String &url)
+    {
+        String s = url;
+        int p = s.indexOf("://");
+        if (p > -1)
+            s.remove(0, p + 3);
+
+        ns.remove(0, ns.length());
+        p = s.indexOf("ns=");
+        if (p > -1)
+        {
+            ns = s.substring(p + 3);
+            if (ns.indexOf('&') > -1)
+                ns.remove(ns.indexOf('&'));
+        }
+
+        p = s.indexOf('?');
+        if (p > -1)
+            s.remove(p);
+        if (s.length() && s[s.length() - 1] == '/')
+            s.remove(s.length() - 1);
+
+        port = 443;
+        p = s.indexOf(':');
+        if (p > -1)
+        {
+            port = s.substring(p + 1).toInt();
+            s.remove(p);
+        }
+
+        host = s;
+        server_host = s;
+        if (ns.length() == 0 && s.indexOf('.') > -1)
+            ns = s.substring(0, s.indexOf('.'));
+    }
+
+    /**
+     * Set the network client.
+     *
+     * @param client The SSL client e.g. BSSL_SSL_Client or the plain client for the local server.
+     *
+     * The client is connected from DatabaseSocket::loop and should not be shared with the async client.
+     */
+    void setClient(Client &client) { this->client = &client; }
+
+    /**
+     * Check if the connection was established and the requests can be sent.
+     *
+     * @return bool Returns true when the handshake of server was received.
+     */
+    bool ready() const { return state == state_ready; }
+
+    /**
+     * Get the error of connection or authentication.
+     *
+     * @return FirebaseError The FirebaseError object that contains the last error information.
+     */
+    FirebaseError lastError() const { return err; }
+
+    /**
+     * Set value to database.
+     *
+     * @param path The node path to set the value.
+     * @param value The value to set.
+     * @param cb The async result callback (AsyncResultCallback) which is called when the write was acknowledged or rejected.
+     * @param uid The user specified UID of async result (optional).
+     *
+     * The value type can be primitive types, Arduino String, string_t, number_t, boolean_t and object_t.
+     */
+    template <typename T = const char *>
+    void set(const String &path, T value, AsyncResultCallback cb, const String &uid = "")
+    {
+        ValueConverter vcon;
+        String payload;
+        vcon.getVal<T>(payload, value);
+        addRequest(action_put, path, payload, cb, uid);
+    }
+
+    /**
+     * Update (patch) JSON object to database.
+     *
+     * @param path The node path to update.
+     * @param value The JSON object (object_t) to update.
+     * @param cb The async result callback (AsyncResultCallback) which is called when the write was acknowledged or rejected.
+     * @param uid The user specified UID of async result (optional).
+     */
+    template <typename T = object_t>
+    void update(const String &path, const T &value, AsyncResultCallback cb, const String &uid = "")
+    {
+        ValueConverter vcon;
+        String payload;
+        vcon.getVal<T>(payload, value);
+        addRequest(action_merge, path, payload, cb, uid);
+    }
+
+    /**
+     * Remove node from database.
+     *
+     * @param path The node path to remove.
+     * @param cb The async result callback (AsyncResultCallback) which is called when the write was acknowledged or rejected.
+     * @param uid The user specified UID of async result (optional).
+     */
+    void remove(const String &path, AsyncResultCallback cb, const String &uid = "") { addRequest(action_put, path, "null", cb, uid); }
+
+    /**
+     * Listen to the changes of node.
+     *
+     * @param path The node path to listen.
+     * @param cb The async result callback (AsyncResultCallback) to get the events.
+     * @param uid The user specified UID of async result (optional).
+     *
+     * The events are returned in the same way as the SSE mode (HTTP Streaming) events e.g. the event type,
+     * data path and data can be obtained from RealtimeDatabaseResult.
+     */
+    void listen(const String &path, AsyncResultCallback cb, const String &uid = "") { addRequest(action_listen, path, "", cb, uid); }
+
+    /**
+     * Stop listening to the changes of node.
+     *
+     * @param path The node path that was listened.
+     */
+    void unlisten(const String &path)
+    {
+        String p = "/" + PathUtil::normalize(path);
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            if (requests[i]->action == action_listen && requests[i]->path == p)
+            {
+                if (state == state_ready && requests[i]->sent)
+                    send(action_unlisten, ++request_id, p, "");
+                delete requests[i]->result;
+                delete requests[i];
+                requests.erase(requests.begin() + i);
+                break;
+            }
+        }
+    }
+
+    /**
+     * Close the connection.
+     *
+     * The connection will be established again from DatabaseSocket::loop when any request is pending.
+     */
+    void disconnect()
+    {
+        if (client && state != state_disconnected)
+            client->stop();
+        state = state_disconnected;
+        auth_ts = 0;
+        for (size_t i = 0; i < requests.size(); i++)
+            requests[i]->sent = false;
+    }
+
+    /**
+     * Perform the connection, authentication and message processing.
+     * Should be placed in the main loop function.
+     */
+    void loop()
+    {
+        if (!client || host.length() == 0)
+            return;
+
+        if (state != state_disconnected && !client->connected())
+        {
+            setError(FIREBASE_ERROR_TCP_DISCONNECTED, "");
+            disconnect();
+        }
+
+        if (state == state_disconnected)
+        {
+            if (requests.size() && millis() - retry_ms >= retry_delay)
+                connect();
+            return;
+        }
+
+        if (state == state_handshake)
+            readHandshake();
+
+        if (state == state_open || state == state_ready)
+            readFrames();
+
+        if (state == state_ready)
+        {
+            app_token_t *aToken = appToken();
+            if (aToken && aToken->auth_ts != auth_ts)
+                authenticate(aToken);
+
+            if (millis() - send_ms >= FIREBASE_SOCKET_KEEP_ALIVE_MS)
+                sendText("0");
+        }
+        else if (state != state_disconnected && millis() - connect_ms > 10 * 1000)
+        {
+            setError(FIREBASE_ERROR_TCP_RECEIVE_TIMEOUT, "");
+            disconnect();
+        }
+    }
+
+private:
+    enum socket_state
+    {
+        state_disconnected,
+        state_handshake,
+        state_open,
+        state_ready
+    };
+
+    enum socket_action
+    {
+        action_put,
+        action_merge,
+        action_listen,
+        action_unlisten,
+        action_auth,
+        action_gauth
+    };
+
+    struct request_t
+    {
+        socket_action action = action_put;
+        uint32_t id = 0;
+        String path, payload;
+        AsyncResult *result = nullptr;
+        AsyncResultCallback cb = NULL;
+        bool sent = false, initial = true;
+    };
+
+    std::vector<request_t *> requests;
+    Client *client = nullptr;
+    String host, server_host, ns, header, message, frames;
+    uint16_t port = 443;
+    socket_state state = state_disconnected;
+    uint32_t request_id = 0, auth_id = 0, auth_ts = 0;
+    unsigned long connect_ms = 0, send_ms = 0, retry_ms = 0, retry_delay = 0;
+    uint32_t frames_left = 0;
+    FirebaseError err;
+
+    // The received frame header and payload.
+    uint8_t rx_hdr[14], rx_ctrl[125];
+    size_t rx_hdr_len = 0, rx_ctrl_len = 0;
+    uint64_t rx_remaining = 0;
+    bool rx_payload = false;
+
+    // FirebaseApp address and FirebaseApp vector address
+    uint32_t app_addr = 0, avec_addr = 0;
+    uint32_t ul_dl_task_running_addr = 0;
+    app_token_t *app_token = nullptr;
+
+    void setApp(uint32_t app_addr, app_token_t *app_token, uint32_t avec_addr, uint32_t ul_dl_task_running_addr)
+    {
+        this->app_addr = app_addr;
+        this->app_token = app_token;
+        this->avec_addr = avec_addr; // AsyncClient vector (list) address
+        this->ul_dl_task_running_addr = ul_dl_task_running_addr;
+    }
+
+    app_token_t *appToken()
+    {
+        if (avec_addr > 0)
+        {
+            const std::vector<uint32_t> *aVec = reinterpret_cast<std::vector<uint32_t> *>(avec_addr);
+            List vec;
+            return vec.existed(*aVec, app_addr) ? app_token : nullptr;
+        }
+        return nullptr;
+    }
+
+    void setError(int code, const String &msg)
+    {
+        if (msg.length())
+            err.setLastError(code, msg);
+        else
+            err.setClientError(code);
+    }
+
+    void addRequest(socket_action action, const String &path, const String &payload, AsyncResultCallback cb, const String &uid)
+    {
+        request_t *req = new request_t();
+        req->action = action;
+        req->path = "/" + PathUtil::normalize(path);
+        req->payload = payload;
+        req->cb = cb;
+        req->result = new AsyncResult();
+        req->result->setUID(uid);
+        req->result->setPath(req->path);
+        requests.push_back(req);
+
+        if (state == state_ready)
+            sendRequest(req);
+    }
+
+    void sendRequest(request_t *req)
+    {
+        req->id = ++request_id;
+        req->initial = true;
+        req->sent = send(req->action, req->id, req->path, req->payload);
+    }
+
+    void connect()
+    {
+        app_token_t *aToken = appToken();
+        if (!aToken || (!aToken->authenticated && aToken->auth_data_type != user_auth_data_no_token))
+            return;
+
+        retry_ms = millis();
+        retry_delay = retry_delay ? retry_delay * 2 : 1000;
+        if (retry_delay > FIREBASE_SOCKET_MAX_RETRY_MS)
+            retry_delay = FIREBASE_SOCKET_MAX_RETRY_MS;
+
+        if (!client->connect(server_host.c_str(), port))
+        {
+            setError(FIREBASE_ERROR_TCP_CONNECTION, "");
+            return;
+        }
+
+        uint8_t key[16];
+        for (size_t i = 0; i < sizeof(key); i++)
+            key[i] = random(256);
+        Memory mem;
+        Base64Util b64ut;
+        char *encoded = b64ut.encodeToChars(mem, key, sizeof(key));
+
+        String request = FPSTR("GET /.ws?v=5&ns=");
+        request += ns;
+        request += FPSTR(" HTTP/1.1\r\nHost: ");
+        request += server_host;
+        request += FPSTR("\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Version: 13\r\nSec-WebSocket-Key: ");
+        request += encoded;
+        request += FPSTR("\r\n\r\n");
+        mem.release(&encoded);
+
+        if (client->write(reinterpret_cast<const uint8_t *>(request.c_str()), request.length()) != request.length())
+        {
+            setError(FIREBASE_ERROR_TCP_SEND, "");
+            client->stop();
+            return;
+        }
+
+        header.remove(0, header.length());
+        state = state_handshake;
+        connect_ms = millis();
+        send_ms = millis();
+    }
+
+    // Read the HTTP upgrade response header byte by byte, the WebSocket frames may follow.
+    void readHandshake()
+    {
+        while (client->available())
+        {
+            int c = client->read();
+            if (c < 0)
+                break;
+            header += (char)c;
+            if (header.endsWith("\r\n\r\n"))
+            {
+                if (header.indexOf(" 101") < 0 || header.indexOf(" 101") > header.indexOf('\n'))
+                {
+                    setError(FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST, header.substring(0, header.indexOf('\r')));
+                    disconnect();
+                    return;
+                }
+                header.remove(0, header.length());
+                message.remove(0, message.length());
+                frames.remove(0, frames.length());
+                frames_left = 0;
+                rx_hdr_len = 0;
+                rx_payload = false;
+                state = state_open;
+                return;
+            }
+            if (header.length() > 2048)
+            {
+                setError(FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST, "");
+                disconnect();
+                return;
+            }
+        }
+    }
+
+    void readFrames()
+    {
+        uint8_t buf[64];
+        while (state != state_disconnected && client->available())
+        {
+            int len = client->read(buf, sizeof(buf));
+            if (len <= 0)
+                break;
+            for (int i = 0; i < len && state != state_disconnected; i++)
+                readFrame(buf[i]);
+        }
+    }
+
+    void readFrame(uint8_t b)
+    {
+        if (!rx_payload)
+        {
+            rx_hdr[rx_hdr_len++] = b;
+            if (rx_hdr_len < 2)
+                return;
+
+            uint8_t len7 = rx_hdr[1] & 0x7f;
+            size_t need = 2 + (len7 == 126 ? 2 : (len7 == 127 ? 8 : 0)) + (rx_hdr[1] & 0x80 ? 4 : 0);
+            if (rx_hdr_len < need)
+                return;
+
+            rx_remaining = len7;
+            if (len7 >= 126)
+            {
+                rx_remaining = 0;
+                for (size_t i = 2; i < (len7 == 126 ? 4u : 10u); i++)
+                    rx_remaining = rx_remaining << 8 | rx_hdr[i];
+            }
+            rx_ctrl_len = 0;
+            rx_payload = true;
+            if (rx_remaining == 0)
+                completeFrame();
+            return;
+        }
+
+        // The server frames are not masked.
+        if ((rx_hdr[0] & 0x08) == 0)
+            message += (char)b;
+        else if (rx_ctrl_len < sizeof(rx_ctrl))
+            rx_ctrl[rx_ctrl_len++] = b;
+
+        if (--rx_remaining == 0)
+            completeFrame();
+    }
+
+    void completeFrame()
+    {
+        uint8_t opcode = rx_hdr[0] & 0x0f;
+        bool fin = rx_hdr[0] & 0x80;
+        rx_hdr_len = 0;
+        rx_payload = false;
+
+        if (opcode == 0x08) // close
+        {
+            setError(FIREBASE_ERROR_TCP_DISCONNECTED, "");
+            disconnect();
+        }
+        else if (opcode == 0x09) // ping
+            sendFrame(0x0a, rx_ctrl, rx_ctrl_len);
+        else if (opcode <= 0x02 && fin)
+        {
+            String msg = message;
+            message.remove(0, message.length());
+            processMessage(msg);
+        }
+    }
+
+    // The large message is sent as the number of messages followed by the messages.
+    void processMessage(const String &msg)
+    {
+        if (frames_left > 0)
+        {
+            frames += msg;
+            if (--frames_left == 0)
+            {
+                String data = frames;
+                frames.remove(0, frames.length());
+                processData(data);
+            }
+            return;
+        }
+
+        if (msg.length() > 0 && msg.length() <= 6)
+        {
+            bool number = true;
+            for (size_t i = 0; i < msg.length(); i++)
+                number &= msg[i] >= '0' && msg[i] <= '9';
+            if (number)
+            {
+                frames_left = msg.toInt();
+                return;
+            }
+        }
+        processData(msg);
+    }
+
+    static String str(const JsonReader &reader, const String &path)
+    {
+        String s = reader.get(path);
+        if (s.length() >= 2 && s[0] == '"')
+            return s.substring(1, s.length() - 1);
+        return s;
+    }
+
+    void processData(const String &data)
+    {
+        JsonReader reader;
+        if (!reader.parse(data))
+            return;
+
+        String t = str(reader, "/t");
+        if (t == "c")
+            processControl(reader);
+        else if (t == "d")
+        {
+            if (reader.existed("/d/r"))
+                processResponse(reader.to<int>("/d/r"), str(reader, "/d/b/s"), reader.get("/d/b/d"));
+            else
+                processAction(str(reader, "/d/a"), str(reader, "/d/b/p"), reader.get("/d/b/d"));
+        }
+    }
+
+    void processControl(const JsonReader &reader)
+    {
+        String t = str(reader, "/d/t");
+        if (t == "h") // handshake
+        {
+            state = state_ready;
+            retry_delay = 0;
+            err.clearError();
+            app_token_t *aToken = appToken();
+            if (aToken)
+                authenticate(aToken);
+            for (size_t i = 0; i < requests.size(); i++)
+                sendRequest(requests[i]);
+        }
+        else if (t == "r") // reset to the other server
+        {
+            server_host = str(reader, "/d/d");
+            disconnect();
+            retry_delay = 0;
+            retry_ms = millis() - 1000;
+        }
+        else if (t == "s") // shutdown
+        {
+            setError(FIREBASE_ERROR_TCP_DISCONNECTED, str(reader, "/d/d"));
+            disconnect();
+        }
+        else if (t == "p") // ping
+            sendText("{\"t\":\"c\",\"d\":{\"t\":\"o\",\"d\":{}}}");
+    }
+
+    void authenticate(app_token_t *aToken)
+    {
+        auth_ts = aToken->auth_ts;
+        if (aToken->auth_data_type == user_auth_data_no_token || aToken->val[app_tk_ns::token].length() == 0)
+            return;
+        bool gauth = aToken->auth_type == auth_access_token || aToken->auth_type == auth_sa_access_token;
+        auth_id = ++request_id;
+        send(gauth ? action_gauth : action_auth, auth_id, "", aToken->val[app_tk_ns::token]);
+    }
+
+    void processResponse(uint32_t id, const String &status, const String &data)
+    {
+        if (id == auth_id)
+        {
+            if (status != "ok")
+                setError(FIREBASE_ERROR_UNAUTHENTICATE, status);
+            return;
+        }
+
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            request_t *req = requests[i];
+            if (req->id != id || !req->sent)
+                continue;
+
+            bool listen = req->action == action_listen;
+            if (status != "ok")
+            {
+                String msg = status;
+                if (data.length() > 2 && data[0] == '"')
+                    msg += ", " + data.substring(1, data.length() - 1);
+                req->result->lastError.setLastError(status == "permission_denied" ? FIREBASE_ERROR_HTTP_CODE_UNAUTHORIZED : FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST, msg);
+            }
+            else if (listen)
+                return;
+            else
+                req->result->lastError.reset();
+
+            if (req->cb)
+                req->cb(*req->result);
+
+            delete req->result;
+            delete req;
+            requests.erase(requests.begin() + i);
+            return;
+        }
+    }
+
+    // The data, merge, listen revoked and auth revoked actions from server.
+    void processAction(const String &action, const String &path, const String &data)
+    {
+        sse_event_type type = sse_event_type_undefined;
+        if (action == "d")
+            type = sse_event_type_put;
+        else if (action == "m")
+            type = sse_event_type_patch;
+        else if (action == "c")
+            type = sse_event_type_cancel;
+        else if (action == "ac")
+            type = sse_event_type_auth_revoked;
+        else
+            return;
+
+        String p = "/" + PathUtil::normalize(path);
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            request_t *req = requests[i];
+            if (req->action != action_listen)
+                continue;
+
+            String rel;
+            if (type == sse_event_type_auth_revoked)
+                rel = "/";
+            else if (req->path == "/" || p == req->path)
+                rel = p == req->path ? "/" : p;
+            else if (p.startsWith(req->path) && p[req->path.length()] == '/')
+                rel = p.substring(req->path.length());
+            else
+                continue;
+
+            if (type == sse_event_type_cancel && rel != "/")
+                continue;
+
+            sse_event_t ev;
+            ev.type = type == sse_event_type_put && req->initial ? sse_event_type_get : type;
+            req->initial = false;
+
+            String name = type == sse_event_type_put ? "put" : (type == sse_event_type_patch ? "patch" : (type == sse_event_type_cancel ? "cancel" : "auth_revoked"));
+            String payload = "event: " + name;
+            ev.event_p1 = 7;
+            ev.event_p2 = payload.length();
+            payload += "\ndata: ";
+            if (type == sse_event_type_put || type == sse_event_type_patch)
+            {
+                payload += "{\"path\":\"";
+                ev.path_p1 = payload.length();
+                payload += rel;
+                ev.path_p2 = payload.length();
+                payload += "\",\"data\":";
+                ev.data_p1 = payload.length();
+                payload += data;
+                ev.data_p2 = payload.length();
+                payload += '}';
+            }
+            else
+            {
+                ev.data_p1 = payload.length();
+                payload += data;
+                ev.data_p2 = payload.length();
+            }
+            payload += '\n';
+
+            req->result->setPayload(payload);
+            setSSE(&req->result->rtdbResult, ev);
+            if (req->cb)
+                req->cb(*req->result);
+        }
+    }
+
+    bool send(socket_action action, uint32_t id, const String &path, const String &data)
+    {
+        static const char *actions[] = {"p", "m", "q", "n", "auth", "gauth"};
+        String msg;
+        msg.reserve(path.length() + data.length() + 48);
+        msg = FPSTR("{\"t\":\"d\",\"d\":{\"r\":");
+        msg += id;
+        msg += FPSTR(",\"a\":\"");
+        msg += actions[action];
+        msg += FPSTR("\",\"b\":{");
+        if (action == action_auth || action == action_gauth)
+        {
+            msg += FPSTR("\"cred\":\"");
+            msg += data;
+            msg += '"';
+        }
+        else
+        {
+            msg += FPSTR("\"p\":\"");
+            msg += path;
+            msg += '"';
+            if (action == action_listen)
+                msg += FPSTR(",\"h\":\"\"");
+            else if (action != action_unlisten)
+            {
+                msg += FPSTR(",\"d\":");
+                msg += data;
+            }
+        }
+        msg += FPSTR("}}}");
+        return sendText(msg);
+    }
+
+    bool sendText(const String &msg)
+    {
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(msg.c_str());
+        if (msg.length() <= FIREBASE_SOCKET_FRAME_SIZE)
+            return sendFrame(0x01, data, msg.length());
+
+        size_t count = (msg.length() + FIREBASE_SOCKET_FRAME_SIZE - 1) / FIREBASE_SOCKET_FRAME_SIZE;
+        String num(count);
+        if (!sendFrame(0x01, reinterpret_cast<const uint8_t *>(num.c_str()), num.length()))
+            return false;
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t len = i + 1 < count ? FIREBASE_SOCKET_FRAME_SIZE : msg.length() - i * FIREBASE_SOCKET_FRAME_SIZE;
+            if (!sendFrame(0x01, data + i * FIREBASE_SOCKET_FRAME_SIZE, len))
+                return false;
+        }
+        return true;
+    }
+
+    // Send the masked frame.
+    bool sendFrame(uint8_t opcode, const uint8_t *data, size_t len)
+    {
+        if (!client || state == state_disconnected)
+            return false;
+
+        uint8_t hdr[14];
+        size_t hlen = 2;
+        hdr[0] = 0x80 | opcode;
+        if (len < 126)
+            hdr[1] = 0x80 | len;
+        else if (len <= 0xffff)
+        {
+            hdr[1] = 0x80 | 126;
+            hdr[hlen++] = len >> 8;
+            hdr[hlen++] = len & 0xff;
+        }
+        else
+        {
+            hdr[1] = 0x80 | 127;
+            for (int i = 7; i >= 0; i--)
+                hdr[hlen++] = i < 4 ? (len >> (i * 8)) & 0xff : 0;
+        }
+
+        uint8_t *mask = hdr + hlen;
+        for (size_t i = 0; i < 4; i++)
+            mask[i] = random(256);
+        hlen += 4;
+
+        bool ret = client->write(hdr, hlen) == hlen;
+        uint8_t buf[64];
+        for (size_t i = 0; ret && i < len; i += sizeof(buf))
+        {
+            size_t n = len - i < sizeof(buf) ? len - i : sizeof(buf);
+            for (size_t j = 0; j < n; j++)
+                buf[j] = data[i + j] ^ mask[(i + j) % 4];
+            ret = client->write(buf, n) == n;
+        }
+
+        if (!ret)
+        {
+            setError(FIREBASE_ERROR_TCP_SEND, "");
+            disconnect();
+        }
+        send_ms = millis();
+        return ret;
+    }
+};
+
+#endif
+
+#endif
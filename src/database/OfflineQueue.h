@@ -0,0 +1,529 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_OFFLINE_QUEUE_H
+#define DATABASE_OFFLINE_QUEUE_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/FileConfig.h"
+#include "./core/Timer.h"
+#include "./core/PathUtil.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The seconds to wait before replaying the queued operations again after the replay failed.
+#define FIREBASE_OFFLINE_QUEUE_RETRY_INTERVAL 5
+
+/**
+ * The journal of the Realtime database write operations (set, update, push and remove) that were
+ * called while the network is disconnected.
+ *
+ * The journal is stored in the caller provided memory region or the file, the operations are replayed in order
+ * from RealtimeDatabase::loop when the network is connected.
+ *
+ * The queued operation that is superseded by the later set or remove operation at the same path
+ * or its parent path will not be sent.
+ */
+class OfflineQueue
+{
+    friend class RealtimeDatabase;
+
+public:
+    OfflineQueue() { retry_timer.feed(0); }
+    OfflineQueue(const OfflineQueue &) = delete;
+    OfflineQueue &operator=(const OfflineQueue &) = delete;
+
+    ~OfflineQueue() { clearInflight(); }
+
+    /**
+     * Use the memory region to store the journal.
+     *
+     * @param buf The pointer to the memory region.
+     * @param size The size of memory region in bytes.
+     *
+     * The journal header is kept in the memory region, then the memory region that is retained
+     * e.g. the RTC memory can keep the queued operations through the deep sleep.
+     */
+    void setBuffer(uint8_t *buf, size_t size)
+    {
+        reset();
+        file = nullptr;
+        mem = size > header_size ? buf : nullptr;
+        mem_size = mem ? size : 0;
+
+        if (!mem)
+            return;
+
+        uint32_t hdr[3];
+        memcpy(hdr, mem, header_size);
+        if (hdr[0] == journal_magic && hdr[1] <= hdr[2] && hdr[2] <= mem_size - header_size)
+        {
+            head = hdr[1];
+            tail = hdr[2];
+        }
+        cursor = head;
+        writeHeader();
+        buildIndex();
+    }
+
+#if defined(ENABLE_FS)
+    /**
+     * Use the file to store the journal.
+     *
+     * @param file The filesystem data (file_config_data) obtained from FileConfig class object.
+     *
+     * The operations in the file that was left from previous session will be replayed.
+     * The replayed operations are removed from file when all operations were replayed,
+     * then the operations that were replayed before restart can be sent again.
+     */
+    void setFile(file_config_data &file)
+    {
+        reset();
+        mem = nullptr;
+        mem_size = 0;
+        this->file = file.cb && file.filename.length() ? &file : nullptr;
+
+        if (this->file && openFile(file_mode_open_read))
+        {
+            tail = this->file->file.size();
+            this->file->file.close();
+        }
+        buildIndex();
+    }
+#endif
+
+    /**
+     * Set the callback function to get the result of replayed operation.
+     *
+     * @param cb The async result callback (AsyncResultCallback).
+     *
+     * The callback is called when the operation was sent or rejected by server.
+     */
+    void setCallback(AsyncResultCallback cb) { this->cb = cb; }
+
+    // Returns true when all queued operations were sent.
+    bool empty() const { return head == tail && inflight.size() == 0; }
+
+    // The number of bytes used by queued operations.
+    size_t length() const { return tail - head; }
+
+    // The number of operations that were sent.
+    uint32_t replayed() const { return replayed_count; }
+
+    // The number of operations that were not sent because they were superseded by the later operations.
+    uint32_t compacted() const { return compacted_count; }
+
+    /**
+     * Remove all queued operations.
+     */
+    void clear()
+    {
+        clearInflight();
+        head = 0;
+        tail = 0;
+        cursor = 0;
+        retry = false;
+        index.clear();
+        acked.clear();
+#if defined(ENABLE_FS)
+        if (file)
+            file->cb(file->file, file->filename.c_str(), file_mode_remove);
+#endif
+        writeHeader();
+    }
+
+private:
+    // The record is the method, path length (uint16_t), payload length (uint32_t), path and payload.
+    static const size_t record_header_size = 7;
+    static const size_t header_size = 12;
+    static const uint32_t journal_magic = 0x4651424A;
+
+    struct record_t
+    {
+        char method = 0;
+        String path, payload;
+        size_t offset = 0, next = 0;
+    };
+
+    struct index_t
+    {
+        uint32_t hash = 0;
+        size_t offset = 0;
+    };
+
+    struct inflight_t
+    {
+        size_t offset = 0;
+        uint32_t slot_addr = 0;
+        AsyncResult *result = nullptr;
+    };
+
+    uint8_t *mem = nullptr;
+    size_t mem_size = 0;
+    file_config_data *file = nullptr;
+    size_t head = 0, cursor = 0, tail = 0;
+    // The offset of the first record that failed and should be replayed again.
+    size_t retry_offset = 0;
+    std::vector<index_t> index;
+    std::vector<inflight_t> inflight;
+    // The offsets of the records after the head that were sent successfully, they are skipped when replaying again.
+    std::vector<size_t> acked;
+    AsyncResultCallback cb = NULL;
+    bool retry = false;
+    Timer retry_timer;
+    uint32_t replayed_count = 0, compacted_count = 0;
+
+    void reset()
+    {
+        clearInflight();
+        head = 0;
+        cursor = 0;
+        tail = 0;
+        retry = false;
+        index.clear();
+        acked.clear();
+    }
+
+    bool isAcked(size_t offset) const
+    {
+        for (size_t i = 0; i < acked.size(); i++)
+        {
+            if (acked[i] == offset)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Set the result of the replayed record.
+     *
+     * @param offset The offset of the record.
+     * @param sent Set to true when the record was sent or rejected by server, false when it should be replayed again.
+     */
+    void setResult(size_t offset, bool sent)
+    {
+        if (sent)
+            acked.push_back(offset);
+        else if (!retry || offset < retry_offset)
+        {
+            retry = true;
+            retry_offset = offset;
+        }
+    }
+
+    void clearInflight()
+    {
+        for (size_t i = 0; i < inflight.size(); i++)
+            delete inflight[i].result;
+        inflight.clear();
+    }
+
+    bool ready() const { return mem || file; }
+
+    static uint32_t hash(const char *s, size_t len)
+    {
+        uint32_t h = 2166136261UL;
+        for (size_t i = 0; i < len; i++)
+            h = (h ^ (uint8_t)s[i]) * 16777619UL;
+        return h;
+    }
+
+    // The set (put) and remove (delete) replace all data at the path.
+    static bool replaces(char method) { return method == 'P' || method == 'D'; }
+
+    void writeHeader()
+    {
+        if (!mem)
+            return;
+        uint32_t hdr[3] = {journal_magic, (uint32_t)head, (uint32_t)tail};
+        memcpy(mem, hdr, header_size);
+    }
+
+#if defined(ENABLE_FS)
+    bool openFile(file_operating_mode mode)
+    {
+        file->cb(file->file, file->filename.c_str(), mode);
+        return file->file;
+    }
+#endif
+
+    bool read(size_t offset, uint8_t *buf, size_t len)
+    {
+        if (offset + len > tail)
+            return false;
+
+        if (mem)
+        {
+            memcpy(buf, mem + header_size + offset, len);
+            return true;
+        }
+#if defined(ENABLE_FS)
+        if (file && openFile(file_mode_open_read))
+        {
+            bool ret = file->file.seek(offset) && file->file.read(buf, len) == len;
+            file->file.close();
+            return ret;
+        }
+#endif
+        return false;
+    }
+
+    bool readString(size_t offset, size_t len, String &out)
+    {
+        out.remove(0, out.length());
+        if (len == 0)
+            return true;
+
+        char *buf = new char[len + 1];
+        bool ret = read(offset, reinterpret_cast<uint8_t *>(buf), len);
+        if (ret)
+        {
+            buf[len] = 0;
+            out = buf;
+        }
+        delete[] buf;
+        return ret;
+    }
+
+    bool readHeader(size_t offset, char &method, size_t &path_len, size_t &payload_len)
+    {
+        uint8_t hdr[record_header_size];
+        if (!read(offset, hdr, record_header_size))
+            return false;
+        method = hdr[0];
+        path_len = hdr[1] | hdr[2] << 8;
+        payload_len = (uint32_t)hdr[3] | (uint32_t)hdr[4] << 8 | (uint32_t)hdr[5] << 16 | (uint32_t)hdr[6] << 24;
+        return offset + record_header_size + path_len + payload_len <= tail;
+    }
+
+    bool readRecord(size_t offset, record_t &rec)
+    {
+        size_t path_len = 0, payload_len = 0;
+        if (!readHeader(offset, rec.method, path_len, payload_len))
+            return false;
+        rec.offset = offset;
+        rec.next = offset + record_header_size + path_len + payload_len;
+        return readString(offset + record_header_size, path_len, rec.path) &&
+               readString(offset + record_header_size + path_len, payload_len, rec.payload);
+    }
+
+    void buildIndex()
+    {
+        index.clear();
+        size_t offset = head;
+        char method = 0;
+        size_t path_len = 0, payload_len = 0;
+        String path;
+        while (offset < tail && readHeader(offset, method, path_len, payload_len))
+        {
+            if (replaces(method) && readString(offset + record_header_size, path_len, path))
+                addIndex(path.c_str(), path.length(), offset);
+            offset += record_header_size + path_len + payload_len;
+        }
+        // Discard the incomplete record e.g. the power was lost while writing.
+        tail = offset;
+    }
+
+    void addIndex(const char *path, size_t len, size_t offset)
+    {
+        index_t idx;
+        idx.hash = hash(path, len);
+        idx.offset = offset;
+        index.push_back(idx);
+    }
+
+    // Check if the record is superseded by the later set or remove record at the same path or its parent path.
+    bool superseded(const record_t &rec)
+    {
+        size_t len = rec.path.length();
+        String path;
+        while (true)
+        {
+            uint32_t h = hash(rec.path.c_str(), len);
+            for (size_t i = 0; i < index.size(); i++)
+            {
+                char method = 0;
+                size_t path_len = 0, payload_len = 0;
+                if (index[i].offset > rec.offset && index[i].hash == h && readHeader(index[i].offset, method, path_len, payload_len) &&
+                    path_len == len && readString(index[i].offset + record_header_size, path_len, path) && strncmp(path.c_str(), rec.path.c_str(), len) == 0)
+                    return true;
+            }
+
+            if (len == 0)
+                break;
+            while (len > 0 && rec.path[len - 1] != '/')
+                len--;
+            if (len > 0)
+                len--;
+        }
+        return false;
+    }
+
+    // Reclaim the space of sent and superseded records in the memory region.
+    void compact()
+    {
+        if (!mem || inflight.size())
+            return;
+
+        uint8_t *base = mem + header_size;
+        size_t wpos = 0, offset = head;
+        record_t rec;
+        while (offset < tail && readRecord(offset, rec))
+        {
+            if (superseded(rec))
+                compacted_count++;
+            // The record that was sent while the earlier record is waiting to replay again.
+            else if (!isAcked(offset))
+            {
+                memmove(base + wpos, base + offset, rec.next - offset);
+                wpos += rec.next - offset;
+            }
+            offset = rec.next;
+        }
+        head = 0;
+        cursor = 0;
+        retry_offset = 0;
+        tail = wpos;
+        acked.clear();
+        writeHeader();
+        buildIndex();
+    }
+
+    bool add(char method, const String &path, const char *payload)
+    {
+        if (!ready())
+            return false;
+
+        String p = PathUtil::normalize(path);
+        size_t payload_len = strlen(payload);
+        size_t len = record_header_size + p.length() + payload_len;
+
+        if (p.length() > 0xffff)
+            return false;
+
+        if (mem && tail + len > mem_size - header_size)
+        {
+            compact();
+            if (tail + len > mem_size - header_size)
+                return false;
+        }
+
+        uint8_t hdr[record_header_size] = {(uint8_t)method, (uint8_t)(p.length() & 0xff), (uint8_t)(p.length() >> 8),
+                                           (uint8_t)(payload_len & 0xff), (uint8_t)(payload_len >> 8 & 0xff),
+                                           (uint8_t)(payload_len >> 16 & 0xff), (uint8_t)(payload_len >> 24 & 0xff)};
+        if (mem)
+        {
+            uint8_t *base = mem + header_size + tail;
+            memcpy(base, hdr, record_header_size);
+            memcpy(base + record_header_size, p.c_str(), p.length());
+            memcpy(base + record_header_size + p.length(), payload, payload_len);
+        }
+#if defined(ENABLE_FS)
+        else if (file)
+        {
+            if (!openFile(file_mode_open_append))
+                return false;
+            bool ret = file->file.write(hdr, record_header_size) == record_header_size &&
+                       file->file.write(reinterpret_cast<const uint8_t *>(p.c_str()), p.length()) == p.length() &&
+                       file->file.write(reinterpret_cast<const uint8_t *>(payload), payload_len) == payload_len;
+            file->file.close();
+            if (!ret)
+                return false;
+        }
+#endif
+        if (replaces(method))
+            addIndex(p.c_str(), p.length(), tail);
+
+        tail += len;
+        writeHeader();
+        return true;
+    }
+
+    // Get the next record to send, the superseded records are skipped.
+    bool next(record_t &rec)
+    {
+        while (cursor < tail)
+        {
+            if (!readRecord(cursor, rec))
+            {
+                // The unreadable journal.
+                cursor = tail;
+                break;
+            }
+
+            cursor = rec.next;
+            if (isAcked(rec.offset))
+                continue;
+            if (!superseded(rec))
+                return true;
+            compacted_count++;
+        }
+        updateHead();
+        return false;
+    }
+
+    // The head is the first record that was not sent successfully.
+    void updateHead()
+    {
+        head = inflight.size() ? inflight[0].offset : cursor;
+        if (retry && retry_offset < head)
+            head = retry_offset;
+
+        if (head == tail && inflight.size() == 0 && tail > 0)
+        {
+            head = 0;
+            cursor = 0;
+            tail = 0;
+            index.clear();
+            acked.clear();
+#if defined(ENABLE_FS)
+            if (file)
+                file->cb(file->file, file->filename.c_str(), file_mode_remove);
+#endif
+        }
+        else
+        {
+            // Remove the index of sent records.
+            for (int i = index.size() - 1; i >= 0; i--)
+            {
+                if (index[i].offset < head)
+                    index.erase(index.begin() + i);
+            }
+
+            for (int i = acked.size() - 1; i >= 0; i--)
+            {
+                if (acked[i] < head)
+                    acked.erase(acked.begin() + i);
+            }
+        }
+        writeHeader();
+    }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_PUSH_ID_H
+#define DATABASE_PUSH_ID_H
+
+#include <Arduino.h>
+#if defined(ESP32) || defined(ESP8266) || defined(CORE_ARDUINO_PICO)
+#include <sys/time.h>
+#endif
+#include "./Config.h"
+#include "./core/Options.h"
+
+#if defined(ENABLE_DATABASE)
+
+/**
+ * The generator of chronologically ordered push IDs (node names) which are compatible with the
+ * 20 characters push IDs generated by the Firebase server and SDKs.
+ *
+ * The first 8 characters are the timestamp in milliseconds and the last 12 characters are random.
+ * The push IDs generated within the same millisecond are still ordered by incrementing the random part.
+ *
+ * The random part uses the hardware random number generator on ESP32 and ESP8266. On other targets, the
+ * random() generator is seeded from micros() when the first push ID is generated, the application can call
+ * randomSeed() with its own entropy source (e.g. the reading of an unconnected analog pin) before that.
+ */
+class PushID
+{
+public:
+    PushID() {}
+
+    /**
+     * Set the current UNIX timestamp in seconds.
+     *
+     * @param ts The current UNIX timestamp in seconds.
+     *
+     * The timestamp of push ID is this time plus the milliseconds elapsed since it was set.
+     * When it was not set, the system time will be used (ESP32, ESP8266 and Raspberry Pi Pico)
+     * or the milliseconds since device boot which are ordered only until the device restarts.
+     */
+    void setTime(uint32_t ts)
+    {
+        base_ts = ts;
+        base_ms = millis();
+    }
+
+    /**
+     * Generate the push ID from the current time.
+     *
+     * @return String The push ID.
+     */
+    String get() { return get(now()); }
+
+    /**
+     * Generate the push ID.
+     *
+     * @param ms The UNIX timestamp in milliseconds.
+     * @return String The push ID.
+     */
+    String get(uint64_t ms)
+    {
+        static const char chars[] = "-0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz";
+
+        // Keep the order when the clock goes back or the push IDs are generated within the same millisecond.
+        bool duplicate = ms <= last_ms && last_ms > 0;
+        if (duplicate)
+            ms = last_ms;
+        last_ms = ms;
+
+        char id[21];
+        for (int i = 7; i >= 0; i--)
+        {
+            id[i] = chars[ms % 64];
+            ms /= 64;
+        }
+
+        if (duplicate)
+        {
+            int i = 11;
+            while (i >= 0 && last_rand[i] == 63)
+                last_rand[i--] = 0;
+            if (i >= 0)
+                last_rand[i]++;
+        }
+        else
+        {
+#if !defined(ESP32) && !defined(ESP8266)
+            // Mix the application seed (if any) with the time of the first push ID.
+            if (!seeded)
+                randomSeed(random(0x7fffffff) ^ micros());
+            seeded = true;
+#endif
+            for (int i = 0; i < 12; i++)
+                last_rand[i] = random(64);
+        }
+
+        for (int i = 0; i < 12; i++)
+            id[8 + i] = chars[last_rand[i]];
+        id[20] = 0;
+
+        return id;
+    }
+
+private:
+    uint32_t base_ts = 0;
+    unsigned long base_ms = 0;
+    uint64_t last_ms = 0;
+    uint8_t last_rand[12];
+    bool seeded = false;
+
+    uint64_t now()
+    {
+        if (base_ts >= FIREBASE_DEFAULT_TS)
+            return (uint64_t)base_ts * 1000 + (millis() - base_ms);
+
+#if defined(ESP32) || defined(ESP8266) || defined(CORE_ARDUINO_PICO)
+        struct timeval tv;
+        if (gettimeofday(&tv, nullptr) == 0 && tv.tv_sec >= FIREBASE_DEFAULT_TS)
+            return (uint64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+#endif
+        return millis();
+    }
+};
+
+#endif
+
+#endif
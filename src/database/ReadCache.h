@@ -0,0 +1,188 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_READ_CACHE_H
+#define DATABASE_READ_CACHE_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/PathUtil.h"
+
+#if defined(ENABLE_DATABASE)
+
+/**
+ * The bounded least recently used cache of Realtime database read (get) results.
+ *
+ * The cached data is keyed by the node path and query parameters, it is returned without request
+ * until its time to live was expired, then the node is read again and its ETag is compared.
+ */
+class ReadCache
+{
+    friend class RealtimeDatabase;
+
+public:
+    /**
+     * @param capacity The maximum number of cached nodes.
+     * @param ttl The time to live of cached data in milliseconds.
+     * @param maxSize The maximum size in bytes of data to cache.
+     */
+    explicit ReadCache(uint8_t capacity = 8, uint32_t ttl = 5000, size_t maxSize = 1024)
+    {
+        this->capacity = capacity;
+        this->ttl = ttl;
+        this->max_size = maxSize;
+    }
+
+    /**
+     * Set the maximum number of cached nodes.
+     *
+     * @param capacity The maximum number of cached nodes.
+     * @param maxSize The maximum size in bytes of data to cache.
+     *
+     * The least recently used data will be removed when the number of cached nodes is greater than capacity.
+     */
+    void setCapacity(uint8_t capacity, size_t maxSize = 1024)
+    {
+        this->capacity = capacity;
+        this->max_size = maxSize;
+        evict();
+    }
+
+    /**
+     * Set the time to live of cached data.
+     *
+     * @param ttl The time to live in milliseconds.
+     */
+    void setTTL(uint32_t ttl) { this->ttl = ttl; }
+
+    /**
+     * Remove the cached data of the node path, its parent nodes and child nodes.
+     *
+     * @param path The node path.
+     *
+     * This is called when the set, update, push and remove operations were called from RealtimeDatabase.
+     */
+    void invalidate(const String &path)
+    {
+        String p = PathUtil::normalize(path);
+        for (int i = entries.size() - 1; i >= 0; i--)
+        {
+            if (PathUtil::under(entries[i].path, p) || PathUtil::under(p, entries[i].path))
+                entries.erase(entries.begin() + i);
+        }
+    }
+
+    // Remove all cached data, the statistics are kept.
+    void clear() { entries.clear(); }
+
+    // The number of cached nodes.
+    size_t size() const { return entries.size(); }
+
+    // The number of reads that were returned from the cached data.
+    uint32_t hits() const { return hit_count; }
+
+    // The number of reads that were requested.
+    uint32_t misses() const { return miss_count; }
+
+    // The number of requested reads that the ETag of node was not changed.
+    uint32_t revalidated() const { return revalidated_count; }
+
+    // The total size in bytes of data that were returned from the cached data.
+    uint32_t bytesSaved() const { return saved_bytes; }
+
+private:
+    struct entry_t
+    {
+        String key, path, payload, etag;
+        unsigned long ms = 0;
+    };
+
+    // The cached data, the least recently used data first.
+    std::vector<entry_t> entries;
+    uint8_t capacity = 8;
+    uint32_t ttl = 5000;
+    size_t max_size = 1024;
+    uint32_t hit_count = 0, miss_count = 0, revalidated_count = 0, saved_bytes = 0;
+
+    // Get the index of cached data that was not expired.
+    int find(const String &key) const
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].key == key)
+                return millis() - entries[i].ms < ttl ? i : -1;
+        }
+        return -1;
+    }
+
+    // Move the data to the most recently used position.
+    entry_t &hit(int index)
+    {
+        if ((size_t)index + 1 < entries.size())
+        {
+            entries.push_back(entries[index]);
+            entries.erase(entries.begin() + index);
+        }
+        hit_count++;
+        saved_bytes += entries.back().payload.length();
+        return entries.back();
+    }
+
+    void store(const String &key, const String &path, const String &payload, const String &etag)
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].key == key)
+            {
+                if (etag.length() && entries[i].etag == etag)
+                    revalidated_count++;
+                entries.erase(entries.begin() + i);
+                break;
+            }
+        }
+
+        if (capacity == 0 || payload.length() > max_size)
+            return;
+
+        entry_t entry;
+        entry.key = key;
+        entry.path = PathUtil::normalize(path);
+        entry.payload = payload;
+        entry.etag = etag;
+        entry.ms = millis();
+        entries.push_back(entry);
+        evict();
+    }
+
+    void evict()
+    {
+        while (entries.size() > capacity)
+            entries.erase(entries.begin());
+    }
+};
+
+#endif
+
+#endif
@@ -27,6 +27,15 @@
 #include <Arduino.h>
 #include "./core/FirebaseApp.h"
 #include "./database/DataOptions.h"
+#include "./database/DatabaseMirror.h"
+#include "./database/DatabaseIterator.h"
+#include "./database/DatabaseExport.h"
+#include "./database/DatabaseImport.h"
+#include "./database/OfflineQueue.h"
+#include "./database/PushID.h"
+#include "./database/ReadCache.h"
+#include "./database/StateSnapshot.h"
+#include "./database/WriteCombiner.h"
 
 using namespace firebase;
 
@@ -54,6 +63,29 @@ public:
 
     ~RealtimeDatabase()
     {
+        for (size_t i = 0; i < write_batches.size(); i++)
+        {
+            delete write_batches[i]->result;
+            delete write_batches[i];
+        }
+
+        for (size_t i = 0; i < transactions.size(); i++)
+        {
+            delete transactions[i]->result;
+            delete transactions[i];
+        }
+
+        for (size_t i = 0; i < cached_reads.size(); i++)
+        {
+            delete cached_reads[i]->result;
+            delete cached_reads[i];
+        }
+
+        for (size_t i = 0; i < state_updates.size(); i++)
+        {
+            delete state_updates[i]->result;
+            delete state_updates[i];
+        }
     }
 
     /**
@@ -800,6 +832,72 @@ public:
         storeAsync(aClient, path, value, async_request_handler_t::http_patch, true, nullptr, cb, uid);
     }
 
+    /**
+     * Update (patch) the changes of JSON object from the last synced JSON object to database.
+     *
+     * ### Example
+     * ```cpp
+     * StateSnapshot snapshot;
+     *
+     * bool status = Database.updateState<object_t>(aClient, "/devices/device1", snapshot, object_t(deviceStateJson));
+     * ```
+     * @param aClient The async client.
+     * @param path The node path to update.
+     * @param snapshot The StateSnapshot object that keeps the last synced JSON object of node.
+     * @param value The JSON object of node state.
+     * @return boolean value indicates the operating status, it is true when nothing was changed.
+     *
+     * The changed values and the removed keys (as null) are sent as multi-path update, the whole JSON object is sent with set operation
+     * when the last synced JSON object was not set or the multi-path update is larger than the JSON object.
+     * The request is not sent when nothing was changed.
+     *
+     * The snapshot is cleared when the operation failed, then the next operation will send the whole JSON object.
+     */
+    template <typename T = object_t>
+    bool updateState(AsyncClientClass &aClient, const String &path, StateSnapshot &snapshot, const T &value)
+    {
+        return stateUpdate<T>(aClient, path, snapshot, value, false, aClient.getResult(), NULL, "");
+    }
+
+    /**
+     * Update (patch) the changes of JSON object from the last synced JSON object to database.
+     *
+     * ### Example
+     * ```cpp
+     * Database.updateState<object_t>(aClient, "/devices/device1", snapshot, object_t(deviceStateJson), aResult);
+     * ```
+     * @param aClient The async client.
+     * @param path The node path to update.
+     * @param snapshot The StateSnapshot object that keeps the last synced JSON object of node.
+     * @param value The JSON object of node state.
+     * @param aResult The async result (AsyncResult).
+     */
+    template <typename T = object_t>
+    void updateState(AsyncClientClass &aClient, const String &path, StateSnapshot &snapshot, const T &value, AsyncResult &aResult)
+    {
+        stateUpdate<T>(aClient, path, snapshot, value, true, &aResult, NULL, "");
+    }
+
+    /**
+     * Update (patch) the changes of JSON object from the last synced JSON object to database.
+     *
+     * ### Example
+     * ```cpp
+     * Database.updateState<object_t>(aClient, "/devices/device1", snapshot, object_t(deviceStateJson), cb);
+     * ```
+     * @param aClient The async client.
+     * @param path The node path to update.
+     * @param snapshot The StateSnapshot object that keeps the last synced JSON object of node.
+     * @param value The JSON object of node state.
+     * @param cb The async result callback (AsyncResultCallback).
+     * @param uid The user specified UID of async result (optional).
+     */
+    template <typename T = object_t>
+    void updateState(AsyncClientClass &aClient, const String &path, StateSnapshot &snapshot, const T &value, AsyncResultCallback cb, const String &uid = "")
+    {
+        stateUpdate<T>(aClient, path, snapshot, value, true, nullptr, cb, uid);
+    }
+
     /**
      * Remove node from database
      *
@@ -855,6 +953,216 @@ public:
         asyncRequest(aReq);
     }
 
+    /**
+     * Read, modify and write node data in the compare-and-set transaction.
+     *
+     * ### Example
+     * ```cpp
+     * bool increment(const String &current, String &next)
+     * {
+     *     next = String(current.toInt() + 1);
+     *     return true;
+     * }
+     *
+     * bool status = Database.transaction(aClient, "/path/to/counter", increment);
+     * ```
+     * @param aClient The async client.
+     * @param path The node path to modify.
+     * @param update The TransactionUpdateCallback function to get the new data from the current data.
+     * @return boolean value indicates the operating status.
+     *
+     * The node data and its ETag are read, then the new data is written only when the ETag of node was not changed.
+     * When the node was changed, the update function is called again with the current data and ETag from the rejected write
+     * (without reading the node again) after the backoff delay, up to FIREBASE_TRANSACTION_MAX_ATTEMPTS writes.
+     *
+     * The number of writes can be obtained from RealtimeDatabaseResult::transactionAttempts.
+     */
+    bool transaction(AsyncClientClass &aClient, const String &path, TransactionUpdateCallback update)
+    {
+        transaction_t tx;
+        tx.client = &aClient;
+        tx.path = path;
+        tx.update = update;
+        tx.aResult = aClient.getResult();
+        while (!processTransaction(&tx))
+            delay(1);
+        return aClient.getResult()->lastError.code() == 0;
+    }
+
+    /**
+     * Read, modify and write node data in the compare-and-set transaction.
+     *
+     * ### Example
+     * ```cpp
+     * Database.transaction(aClient, "/path/to/counter", increment, aResult);
+     * ```
+     * @param aClient The async client.
+     * @param path The node path to modify.
+     * @param update The TransactionUpdateCallback function to get the new data from the current data.
+     * @param aResult The async result (AsyncResult).
+     */
+    void transaction(AsyncClientClass &aClient, const String &path, TransactionUpdateCallback update, AsyncResult &aResult)
+    {
+        addTransaction(aClient, path, update, &aResult, NULL, "");
+    }
+
+    /**
+     * Read, modify and write node data in the compare-and-set transaction.
+     *
+     * ### Example
+     * ```cpp
+     * Database.transaction(aClient, "/path/to/counter", increment, cb);
+     * ```
+     * @param aClient The async client.
+     * @param path The node path to modify.
+     * @param update The TransactionUpdateCallback function to get the new data from the current data.
+     * @param cb The async result callback (AsyncResultCallback).
+     * @param uid The user specified UID of async result (optional).
+     */
+    void transaction(AsyncClientClass &aClient, const String &path, TransactionUpdateCallback update, AsyncResultCallback cb, const String &uid = "")
+    {
+        addTransaction(aClient, path, update, nullptr, cb, uid);
+    }
+
+    /**
+     * Iterate the child nodes of node in pages ordered by key.
+     *
+     * ### Example
+     * ```cpp
+     * DatabaseIterator iterator(100);
+     *
+     * Database.iterate(aClient, "/path/to/data", iterator);
+     *
+     * // In loop
+     * Database.loop();
+     * while (iterator.next())
+     *     Serial.println(iterator.key());
+     * ```
+     * @param aClient The async client.
+     * @param path The node path.
+     * @param iterator The DatabaseIterator object to iterate the child nodes.
+     *
+     * The child nodes are requested with orderBy="$key", startAt and limitToFirst query parameters,
+     * the next page is requested from RealtimeDatabase::loop while the current page is iterated.
+     * The shallow query parameter can not be used with other query parameters, then the page includes the child node data.
+     */
+    void iterate(AsyncClientClass &aClient, const String &path, DatabaseIterator &iterator) { startIterator(aClient, path, iterator, ""); }
+
+#if defined(ENABLE_FS)
+    /**
+     * Export the child nodes of node to the NDJSON file.
+     *
+     * ### Example
+     * ```cpp
+     * FileConfig exportFile("/backup.ndjson", fileCallback);
+     * DatabaseExport exporter(100);
+     *
+     * Database.exportNode(aClient, "/path/to/data", getFile(exportFile), exporter, true);
+     *
+     * // In loop
+     * Database.loop();
+     * if (exporter.done())
+     *     Serial.println(exporter.count());
+     * ```
+     * @param aClient The async client.
+     * @param path The node path.
+     * @param file The filesystem data (file_config_data) obtained from FileConfig class object.
+     * @param exporter The DatabaseExport object.
+     * @param resume The option to append to the file after the cursor of exporter or the last line of file.
+     * The incomplete last line of file (the write that was interrupted) is removed before appending.
+     * When it is false, the file will be removed and all child nodes are exported.
+     *
+     * Each child node is written as one JSON object line ({"<key>":<value>}) when its page was received
+     * in RealtimeDatabase::loop. The child nodes are read in the same way as RealtimeDatabase::iterate.
+     */
+    void exportNode(AsyncClientClass &aClient, const String &path, file_config_data &file, DatabaseExport &exporter, bool resume = false)
+    {
+        exporter.reset();
+        if (!file.cb || file.filename.length() == 0)
+        {
+            exporter.err.setClientError(FIREBASE_ERROR_OPEN_FILE);
+            exporter.finished = true;
+            return;
+        }
+
+        exporter.file = &file;
+        if (!resume)
+        {
+            exporter.cursor_key.remove(0, exporter.cursor_key.length());
+            file.cb(file.file, file.filename.c_str(), file_mode_remove);
+        }
+        else if (!exporter.resumeFile())
+        {
+            exporter.err.setClientError(FIREBASE_ERROR_FILE_WRITE);
+            exporter.finished = true;
+            return;
+        }
+
+        // The exporter is removed from this list when it was destroyed.
+        List vec;
+        vec.addRemoveList(exports, reinterpret_cast<uint32_t>(&exporter), true);
+        exporter.evec_addr = reinterpret_cast<uint32_t>(&exports);
+        startIterator(aClient, path, exporter.iterator, exporter.cursor_key);
+    }
+
+    /**
+     * Import the JSON or NDJSON file to the node.
+     *
+     * ### Example
+     * ```cpp
+     * FileConfig importFile("/backup.ndjson", fileCallback);
+     * FileConfig checkpointFile("/backup.checkpoint", fileCallback);
+     * DatabaseImport importer(4096, 4);
+     *
+     * importer.addClient(aClient2);
+     * importer.setCheckpointFile(getFile(checkpointFile));
+     * Database.importNode(aClient, "/path/to/data", getFile(importFile), importer, true);
+     *
+     * // In loop
+     * Database.loop();
+     * if (importer.done())
+     *     Serial.println(importer.count());
+     * ```
+     * @param aClient The async client which is added to the client pool of importer.
+     * @param path The node path.
+     * @param file The filesystem data (file_config_data) obtained from FileConfig class object.
+     * @param importer The DatabaseImport object.
+     * @param resume The option to resume from the checkpoint of importer or the checkpoint file.
+     * When it is false, all members of file are imported.
+     *
+     * The members of JSON objects in file are written with the multi-path update (PATCH) requests
+     * which are sent from RealtimeDatabase::loop.
+     */
+    void importNode(AsyncClientClass &aClient, const String &path, file_config_data &file, DatabaseImport &importer, bool resume = false)
+    {
+        importer.reset();
+        importer.addClient(aClient);
+        if (!file.cb || file.filename.length() == 0)
+        {
+            importer.err.setClientError(FIREBASE_ERROR_OPEN_FILE);
+            importer.finished = true;
+            return;
+        }
+
+        importer.file = &file;
+        importer.path = path;
+        if (resume)
+            importer.readCheckpoint();
+        else
+        {
+            importer.checkpoint_pos = 0;
+            importer.saveCheckpoint();
+        }
+        importer.resume();
+
+        // The importer is removed from this list when it was destroyed.
+        List vec;
+        vec.addRemoveList(imports, reinterpret_cast<uint32_t>(&importer), true);
+        importer.ivec_addr = reinterpret_cast<uint32_t>(&imports);
+        processImport(&importer);
+    }
+#endif
+
     /**
      * Filtering response payload for SSE mode (HTTP Streaming).
      * @param filter The event keywords for filtering.
@@ -873,7 +1181,183 @@ public:
      */
     void setSSEFilters(const String &filter = "")
     {
-        this->sse_events_filter = filter;
+        this->sse_events_filter = SSEParser::toFilter(filter);
+    }
+
+    /**
+     * Filtering response payload for SSE mode (HTTP Streaming).
+     *
+     * @param mask The sse_event_type bits of the events to allow e.g. `sse_event_type_put | sse_event_type_patch`.
+     *
+     * This is the same as RealtimeDatabase::setSSEFilters with keywords, 0 to allow all Stream events.
+     */
+    void setSSEFilters(uint8_t mask)
+    {
+        this->sse_events_filter = mask;
+    }
+
+    /**
+     * Set the events queue for SSE mode (HTTP Streaming).
+     *
+     * @param capacity The maximum number of queued events or 0 to disable the queue (default).
+     * @param policy The sse_queue_policy enum for queue overflow.
+     *
+     * This is optional and applies to the SSE mode (HTTP Streaming) tasks that start after this call.
+     *
+     * The events are read from the Stream as they arrive and returned one event per loop,
+     * then the events that arrive faster than the application loop will not be overwritten.
+     *
+     * The following policies are supported.
+     * sse_queue_policy_drop_oldest - To drop the oldest queued event.
+     * sse_queue_policy_coalesce - To replace the queued keep-alive event or the queued event that is superseded by the new put event
+     * at the same path or parent path, or drop the oldest queued event.
+     * sse_queue_policy_block - To stop reading the Stream until the queued event was taken.
+     *
+     * The number of queued, lost and coalesced events can be obtained from RealtimeDatabaseResult::queuedEvents,
+     * RealtimeDatabaseResult::lostEvents and RealtimeDatabaseResult::coalescedEvents.
+     */
+    void setSSEQueue(uint16_t capacity, sse_queue_policy policy = sse_queue_policy_drop_oldest)
+    {
+        sse_queue_capacity = capacity;
+        sse_queue_overflow = policy;
+    }
+
+    /**
+     * Set the time window to merge the SSE mode (HTTP Streaming) events.
+     *
+     * @param window The milliseconds to wait for the events to merge since the first pending event was received or 0 to disable (default).
+     *
+     * This is optional and applies to the SSE mode (HTTP Streaming) tasks that start after this call.
+     *
+     * The events that arrive within the time window are merged per path before they are returned, then the intermediate
+     * data will not be returned and the data after the merged events is the same as after all events.
+     *
+     * The put event replaces the pending events at the same path or under its path, the put and patch events are composed
+     * onto the pending put event at the same path or parent path and the patch events at the same path are merged into one patch event.
+     * The keep-alive event is dropped while the events are pending.
+     *
+     * The merged events are added to the events queue when the events queue was set via RealtimeDatabase::setSSEQueue.
+     *
+     * The number of pending and merged events are included in RealtimeDatabaseResult::queuedEvents and RealtimeDatabaseResult::coalescedEvents.
+     */
+    void setSSECoalescing(uint32_t window) { sse_coalesce_window = window; }
+
+    /**
+     * Set the offline queue for the write operations.
+     *
+     * @param aClient The async client to replay the queued operations.
+     * @param queue The OfflineQueue object that stores the operations.
+     * @param concurrency The maximum number of replayed operations that wait in the async client queue.
+     *
+     * The set, update, push and remove operations (except for file and ETag conditional operations)
+     * that were called while the network is disconnected are added to the queue instead of failing,
+     * and the operations that were called while the queue is replaying are also added to keep the order.
+     *
+     * The queued operations are replayed in order from RealtimeDatabase::loop when the network of async client
+     * is connected, the results of replayed operations are returned to the OfflineQueue callback.
+     *
+     * The sync set and update operations return true when the operation was queued, the sync push operation returns the empty string
+     * or the push ID when the push ID generator was set.
+     * The FIREBASE_ERROR_OFFLINE_QUEUE_FULL error will be returned when the queue is full.
+     */
+    void setOfflineQueue(AsyncClientClass &aClient, OfflineQueue &queue, uint8_t concurrency = 4)
+    {
+        offline_client = &aClient;
+        offline_queue = &queue;
+        offline_concurrency = concurrency > 0 ? concurrency : 1;
+        if (offline_concurrency >= FIREBASE_ASYNC_QUEUE_LIMIT)
+            offline_concurrency = FIREBASE_ASYNC_QUEUE_LIMIT - 1;
+    }
+
+    /**
+     * Set the push ID generator for the push operations.
+     *
+     * @param generator The pointer to PushID object or nullptr to use the push ID from server (default).
+     *
+     * The push ID (node name) is generated locally and the push operation is sent as set operation
+     * at the child node of push ID, the push ID is available from RealtimeDatabaseResult::name
+     * before the request was completed and the push operations can be sent back-to-back in write-behind mode.
+     *
+     * The push operations that were added to the offline queue or combined by the write combiner
+     * are replayed or sent as the set operations which are idempotent.
+     */
+    void setPushIDGenerator(PushID *generator) { push_id = generator; }
+
+    /**
+     * Set the read cache for the get operations.
+     *
+     * @param cache The pointer to ReadCache object or nullptr to disable the read cache (default).
+     *
+     * The get operations (except for SSE mode (HTTP Streaming), file and OTA operations) are returned from
+     * the cached data until its time to live was expired, the data is cached by node path and query parameters.
+     *
+     * The cached data of the node path, its parent nodes and child nodes are removed when the set, update, push
+     * and remove operations were called.
+     *
+     * The async get operations that were returned from cached data or the requested get operations
+     * are returned to the AsyncResult or AsyncResultCallback in RealtimeDatabase::loop.
+     */
+    void setReadCache(ReadCache *cache) { read_cache = cache; }
+
+    /**
+     * Set the write-behind mode for the async write operations.
+     *
+     * @param enable Set to true to enable the write-behind mode.
+     *
+     * In write-behind mode, the async set, update, push and remove operations (except for file operations) are silent writes,
+     * the server does not send back the written data and the result is returned to the AsyncResult or AsyncResultCallback
+     * only when error.
+     *
+     * The requests of silent writes in the async client queue are sent back-to-back on the same connection
+     * without waiting for the response of previous request (HTTP pipelining), up to FIREBASE_PIPELINE_DEPTH requests.
+     */
+    void setWriteBehind(bool enable) { write_behind = enable; }
+
+    /**
+     * Set the write combiner for the async set and update operations.
+     *
+     * @param window The maximum time in milliseconds that the operations are kept to combine or 0 to disable (default).
+     * @param maxSize The payload size in bytes of combined request that the operations are sent immediately.
+     *
+     * The async set and update operations (except for file and ETag conditional operations) of the same async client
+     * that were called within the time window are merged into a single multi-path update request at their common parent path.
+     * The later data at the same path or its parent path replaces the earlier data.
+     *
+     * When the combined request was completed, its result is returned to the AsyncResult or AsyncResultCallback
+     * of every operation with the operation path, UID and data. The multi-path update is atomic, the error of
+     * combined request is the error of all its operations.
+     *
+     * The pending operations are sent before other operations of the same async client to keep the order.
+     */
+    void setWriteCombiner(uint32_t window, size_t maxSize = 4096)
+    {
+        combine_window = window;
+        combine_size = maxSize;
+        if (window == 0)
+            flushWrites();
+    }
+
+    /**
+     * Send the pending operations of the write combiner.
+     */
+    void flushWrites()
+    {
+        for (size_t i = 0; i < write_batches.size(); i++)
+        {
+            if (!write_batches[i]->result)
+                sendWriteBatch(write_batches[i]);
+        }
+    }
+
+    /**
+     * Remove the offline queue.
+     *
+     * The queued operations are kept in the OfflineQueue object.
+     */
+    void unsetOfflineQueue()
+    {
+        offline_client = nullptr;
+        offline_queue = nullptr;
     }
 
 #if defined(FIREBASE_OTA_STORAGE)
@@ -904,11 +1388,100 @@ public:
                 client->handleRemove();
             }
         }
+        replayOfflineQueue();
+        processWriteBatches();
+        processTransactions();
+        processCachedReads();
+        processIterators();
+#if defined(ENABLE_FS)
+        processExports();
+        processImports();
+#endif
+        processStateUpdates();
     }
 
 private:
     String service_url;
-    String sse_events_filter;
+    uint8_t sse_events_filter = 0;
+    uint16_t sse_queue_capacity = 0;
+    sse_queue_policy sse_queue_overflow = sse_queue_policy_drop_oldest;
+    uint32_t sse_coalesce_window = 0;
+    AsyncClientClass *offline_client = nullptr;
+    OfflineQueue *offline_queue = nullptr;
+    uint8_t offline_concurrency = 4;
+    bool write_behind = false;
+    PushID *push_id = nullptr;
+    ReadCache *read_cache = nullptr;
+    uint32_t combine_window = 0;
+    size_t combine_size = 4096;
+
+    // The combined operations of async client, the result is created when the combined request was sent.
+    struct write_batch_t
+    {
+        AsyncClientClass *client = nullptr;
+        WriteCombiner combiner;
+        String path;
+        AsyncResult *result = nullptr;
+        uint32_t slot_addr = 0;
+        bool silent = false;
+    };
+    std::vector<write_batch_t *> write_batches;
+
+    // The read-modify-write operation, the result is the result of its current read or write request.
+    struct transaction_t
+    {
+        enum transaction_state
+        {
+            state_undefined,
+            state_read,
+            state_write,
+            state_backoff
+        };
+
+        AsyncClientClass *client = nullptr;
+        String path, uid;
+        TransactionUpdateCallback update = NULL;
+        AsyncResult *aResult = nullptr;
+        AsyncResultCallback cb = NULL;
+        AsyncResult *result = nullptr;
+        uint32_t slot_addr = 0;
+        transaction_state state = state_undefined;
+        bool async = false;
+        uint8_t attempts = 0;
+        unsigned long ms = 0, wait = 0;
+    };
+    std::vector<transaction_t *> transactions;
+
+    // The get operation that is returned from the cached data (without slot) or from the result of request.
+    struct cached_read_t
+    {
+        AsyncClientClass *client = nullptr;
+        String key, path, uid;
+        AsyncResult *aResult = nullptr;
+        AsyncResultCallback cb = NULL;
+        AsyncResult *result = nullptr;
+        uint32_t slot_addr = 0;
+        bool async = false, requested = false;
+    };
+    std::vector<cached_read_t *> cached_reads;
+    std::vector<uint32_t> iterators; // DatabaseIterator vector
+#if defined(ENABLE_FS)
+    std::vector<uint32_t> exports; // DatabaseExport vector
+    std::vector<uint32_t> imports; // DatabaseImport vector
+#endif
+
+    // The update of state snapshot, the snapshot is cleared when the update failed.
+    struct state_update_t
+    {
+        AsyncClientClass *client = nullptr;
+        StateSnapshot *snapshot = nullptr;
+        AsyncResult *aResult = nullptr;
+        AsyncResultCallback cb = NULL;
+        AsyncResult *result = nullptr;
+        uint32_t slot_addr = 0;
+        bool async = false;
+    };
+    std::vector<state_update_t *> state_updates;
 
     // FirebaseApp address and FirebaseApp vector address
     uint32_t app_addr = 0, avec_addr = 0;
@@ -928,6 +1501,12 @@ private:
         file_config_data *file = nullptr;
         AsyncResult *aResult = nullptr;
         AsyncResultCallback cb = NULL;
+        bool replay = false;
+        bool combined = false;
+        bool transaction = false;
+        bool cached = false;
+        bool tracked = false;
+        uint32_t slot_addr = 0;
         async_request_data_t() {}
         async_request_data_t(AsyncClientClass *aClient, const String &path, async_request_handler_t::http_request_method method, slot_options_t opt, DatabaseOptions *options, file_config_data *file, AsyncResult *aResult, AsyncResultCallback cb, const String &uid = "")
         {
@@ -963,19 +1542,72 @@ private:
     }
 
     template <typename T = object_t>
-    bool storeAsync(AsyncClientClass &aClient, const String &path, const T &value, async_request_handler_t::http_request_method mode, bool async, AsyncResult *aResult, AsyncResultCallback cb, const String &uid)
+    bool stateUpdate(AsyncClientClass &aClient, const String &path, StateSnapshot &snapshot, const T &value, bool async, AsyncResult *aResult, AsyncResultCallback cb, const String &uid)
     {
         ValueConverter vcon;
-        String payload;
-        vcon.getVal<T>(payload, value);
+        String json, payload;
+        vcon.getVal<T>(json, value);
+
+        if (!snapshot.diff(json, payload))
+        {
+            if (!async && aResult)
+                aResult->lastError.clearError();
+            return true;
+        }
+
+        bool patch = snapshot.synced() && payload != json;
+        snapshot.snapshot = json;
+
+        state_update_t *su = new state_update_t();
+        su->client = &aClient;
+        su->snapshot = &snapshot;
+        su->aResult = aResult;
+        su->cb = cb;
+        su->async = async;
+        su->result = new AsyncResult();
+
         DatabaseOptions options;
-        if (!async && aClient.reqEtag.length() == 0)
+        if (!async)
             options.silent = true;
-        async_request_data_t aReq(&aClient, path, mode, slot_options_t(false, false, async, payload.indexOf("\".sv\"") > -1, false, false), &options, nullptr, aResult, cb, uid);
+        async_request_data_t aReq(&aClient, path, patch ? async_request_handler_t::http_patch : async_request_handler_t::http_put, slot_options_t(false, false, async, payload.indexOf("\".sv\"") > -1, false, false), &options, nullptr, su->result, NULL, uid);
+        aReq.tracked = true;
         asyncRequest(aReq, payload.c_str());
+        su->slot_addr = aReq.slot_addr;
+
         if (!async)
-            return aResult->lastError.code() == 0;
-        return true;
+        {
+            bool ret = su->result->lastError.code() == 0;
+            completeStateUpdate(su);
+            delete su;
+            return ret;
+        }
+
+        if (aResult)
+        {
+            // The async result is removed from this list when it was destroyed.
+            List vec;
+            vec.addRemoveList(aClient.rVec, reinterpret_cast<uint32_t>(aResult), true);
+            aResult->rvec_addr = reinterpret_cast<uint32_t>(&(aClient.rVec));
+        }
+
+        state_updates.push_back(su);
+        return true;
+    }
+
+    template <typename T = object_t>
+    bool storeAsync(AsyncClientClass &aClient, const String &path, const T &value, async_request_handler_t::http_request_method mode, bool async, AsyncResult *aResult, AsyncResultCallback cb, const String &uid)
+    {
+        ValueConverter vcon;
+        String payload;
+        vcon.getVal<T>(payload, value);
+        DatabaseOptions options;
+        if (!async && aClient.reqEtag.length() == 0)
+            options.silent = true;
+        async_request_data_t aReq(&aClient, path, mode, slot_options_t(false, false, async, payload.indexOf("\".sv\"") > -1, false, false), &options, nullptr, aResult, cb, uid);
+        asyncRequest(aReq, payload.c_str());
+        if (!async)
+            return aResult->lastError.code() == 0;
+        return true;
     }
 
     void asyncRequest(async_request_data_t &request, const char *payload = "")
@@ -985,19 +1617,50 @@ private:
         if (!atoken)
             return setClientError(request, FIREBASE_ERROR_APP_WAS_NOT_ASSIGNED);
 
+        String name = localPushID(request);
+
+        if (read_cache && request.method != async_request_handler_t::http_get && !request.opt.sse)
+            read_cache->invalidate(request.path);
+
+        if (offlineQueued(request, payload))
+            return;
+
+        if (combineWrite(request, payload))
+            return;
+
         request.opt.app_token = atoken;
         request.opt.auth_param = atoken->auth_data_type != user_auth_data_no_token && atoken->auth_type != auth_access_token && atoken->auth_type != auth_sa_access_token;
         String extras = request.opt.auth_param ? ".json?auth=" + String(FIREBASE_AUTH_PLACEHOLDER) : ".json";
 
+        bool silent = isSilentWrite(request);
+        DatabaseOptions silentOptions;
+        if (silent)
+        {
+            if (!request.options)
+                request.options = &silentOptions;
+            request.options->silent = true;
+        }
+
         addParams(request.opt.auth_param, extras, request.method, request.options, request.file);
 
+        if (readCache(request, extras))
+            return;
+
         async_data_item_t *sData = request.aClient->createSlot(request.opt);
 
         if (!sData)
             return setClientError(request, FIREBASE_ERROR_OPERATION_CANCELLED);
 
+        request.slot_addr = sData->addr;
+
         request.aClient->newRequest(sData, service_url, request.path, extras, request.method, request.opt, request.uid);
 
+        sData->silent = silent;
+        sData->conflict_payload = request.transaction;
+
+        if (name.length())
+            setNodeName(&sData->aResult.rtdbResult, name);
+
         if (request.file)
             sData->request.file_data.copy(*request.file);
 
@@ -1034,13 +1697,766 @@ private:
         if (request.aResult)
             sData->setRefResult(request.aResult, reinterpret_cast<uint32_t>(&(request.aClient->rVec)));
 
-        if (sData->sse && sse_events_filter.length())
-            request.aClient->sse_events_filter = sse_events_filter;
+        if (sData->sse)
+        {
+            sData->response.sse_parser.setFilter(sse_events_filter);
+            sData->response.sse_queue.setCapacity(sse_queue_capacity, sse_queue_overflow);
+            sData->response.sse_coalescer.setWindow(sse_coalesce_window);
+        }
 
         request.aClient->process(sData->async);
         request.aClient->handleRemove();
     }
 
+    // Change the push operation to the set operation at the child node of locally generated push ID.
+    String localPushID(async_request_data_t &request)
+    {
+        String name;
+        if (!push_id || request.replay || request.method != async_request_handler_t::http_post || request.opt.sse || request.opt.ota)
+            return name;
+
+        name = push_id->get();
+        request.method = async_request_handler_t::http_put;
+        if (!request.path.endsWith("/"))
+            request.path += '/';
+        request.path += name;
+
+        if (request.aResult)
+            setNodeName(&request.aResult->rtdbResult, name);
+
+        return name;
+    }
+
+    // Add the write operation to the offline queue when network is disconnected or the queue is replaying.
+    bool offlineQueued(async_request_data_t &request, const char *payload)
+    {
+        char method = 0;
+        if (request.method == async_request_handler_t::http_put)
+            method = 'P';
+        else if (request.method == async_request_handler_t::http_patch)
+            method = 'U';
+        else if (request.method == async_request_handler_t::http_post)
+            method = 'O';
+        else if (request.method == async_request_handler_t::http_delete)
+            method = 'D';
+
+        if (!offline_queue || !method || request.replay || request.file || request.opt.sse || request.opt.ota || request.aClient->reqEtag.length())
+            return false;
+
+        if (offline_queue->empty() && request.aClient->networkStatus())
+            return false;
+
+        if (!offline_queue->add(method, request.path, payload))
+        {
+            setClientError(request, FIREBASE_ERROR_OFFLINE_QUEUE_FULL);
+            return true;
+        }
+
+        if (request.aResult)
+            request.aResult->lastError.clearError();
+
+        return true;
+    }
+
+    // The client error, unauthorized, too many requests and server errors can be recovered by replaying again.
+    bool retryable(int code) const
+    {
+        return code < 0 || code == FIREBASE_ERROR_HTTP_CODE_UNAUTHORIZED || code == FIREBASE_ERROR_HTTP_CODE_TOO_MANY_REQUESTS ||
+               code >= FIREBASE_ERROR_HTTP_CODE_INTERNAL_SERVER_ERROR;
+    }
+
+    void replayOfflineQueue()
+    {
+        OfflineQueue *queue = offline_queue;
+        AsyncClientClass *client = offline_client;
+
+        if (!queue || !client)
+            return;
+
+        // The replayed operations are completed in order when their slots were removed from async client.
+        // The operations that were sent are acknowledged even when the earlier operation failed.
+        List vec;
+        while (queue->inflight.size() && !vec.existed(client->sVec, queue->inflight[0].slot_addr))
+        {
+            AsyncResult *result = queue->inflight[0].result;
+            bool sent = !result->isError() || !retryable(result->error().code());
+            if (sent)
+            {
+                queue->replayed_count++;
+                if (queue->cb)
+                    queue->cb(*result);
+            }
+            queue->setResult(queue->inflight[0].offset, sent);
+            delete result;
+            queue->inflight.erase(queue->inflight.begin());
+            queue->updateHead();
+        }
+
+        // Replay again from the first failed operation when all replayed operations were completed,
+        // the operations after it that were sent are skipped.
+        if (queue->retry)
+        {
+            if (queue->inflight.size())
+                return;
+            queue->retry = false;
+            queue->cursor = queue->head;
+            queue->retry_timer.feed(FIREBASE_OFFLINE_QUEUE_RETRY_INTERVAL);
+        }
+
+        if (queue->cursor >= queue->tail || queue->inflight.size() >= offline_concurrency || queue->retry_timer.remaining() > 0 || !client->networkStatus())
+            return;
+
+        OfflineQueue::record_t rec;
+        while (queue->inflight.size() < offline_concurrency && queue->next(rec))
+        {
+            async_request_handler_t::http_request_method method = async_request_handler_t::http_put;
+            if (rec.method == 'U')
+                method = async_request_handler_t::http_patch;
+            else if (rec.method == 'O')
+                method = async_request_handler_t::http_post;
+            else if (rec.method == 'D')
+                method = async_request_handler_t::http_delete;
+
+            OfflineQueue::inflight_t item;
+            item.offset = rec.offset;
+            item.result = new AsyncResult();
+            queue->inflight.push_back(item);
+
+            DatabaseOptions options;
+            options.silent = true;
+            async_request_data_t aReq(client, "/" + rec.path, method, slot_options_t(false, false, true, rec.payload.indexOf("\".sv\"") > -1, false, false), &options, nullptr, item.result, NULL);
+            aReq.replay = true;
+            asyncRequest(aReq, rec.payload.c_str());
+            queue->inflight.back().slot_addr = aReq.slot_addr;
+        }
+    }
+
+    // The replayed operations and the async writes in write-behind mode are silent writes.
+    bool isSilentWrite(const async_request_data_t &request) const
+    {
+        if (request.replay)
+            return true;
+
+        return write_behind && !request.transaction && request.opt.async && !request.file && !request.opt.sse && !request.opt.ota &&
+               (request.method == async_request_handler_t::http_put || request.method == async_request_handler_t::http_patch ||
+                request.method == async_request_handler_t::http_post || request.method == async_request_handler_t::http_delete);
+    }
+
+    // Add the async set or update operation to the write combiner.
+    bool combineWrite(async_request_data_t &request, const char *payload)
+    {
+        write_batch_t *batch = nullptr;
+        for (size_t i = 0; i < write_batches.size(); i++)
+        {
+            if (write_batches[i]->client == request.aClient && !write_batches[i]->result)
+                batch = write_batches[i];
+        }
+
+        bool combinable = combine_window > 0 && !request.combined && !request.replay && !request.tracked && request.opt.async && (request.aResult || request.cb) &&
+                          (request.method == async_request_handler_t::http_put || request.method == async_request_handler_t::http_patch) &&
+                          !request.file && !request.opt.sse && !request.opt.ota && !request.aClient->reqEtag.length();
+
+        if (!combinable)
+        {
+            // Send the pending operations first to keep the order.
+            if (batch && !request.combined)
+                sendWriteBatch(batch);
+            return false;
+        }
+
+        WriteCombiner::item_t item;
+        item.path = request.path;
+        item.payload = payload;
+        item.uid = request.uid;
+        item.patch = request.method == async_request_handler_t::http_patch;
+        item.aResult = request.aResult;
+        item.cb = request.cb;
+
+        if (!batch || !batch->combiner.add(item))
+        {
+            if (batch)
+                sendWriteBatch(batch);
+
+            batch = new write_batch_t();
+            batch->client = request.aClient;
+            if (!batch->combiner.add(item))
+            {
+                delete batch;
+                return false;
+            }
+            write_batches.push_back(batch);
+        }
+
+        if (request.aResult)
+        {
+            // The async result is removed from this list when it was destroyed.
+            List vec;
+            vec.addRemoveList(request.aClient->rVec, reinterpret_cast<uint32_t>(request.aResult), true);
+            request.aResult->rvec_addr = reinterpret_cast<uint32_t>(&(request.aClient->rVec));
+        }
+
+        if (batch->combiner.length() >= combine_size)
+            sendWriteBatch(batch);
+
+        return true;
+    }
+
+    void sendWriteBatch(write_batch_t *batch)
+    {
+        String payload;
+        batch->combiner.getPayload(batch->path, payload);
+        batch->result = new AsyncResult();
+        batch->silent = write_behind;
+
+        async_request_data_t aReq(batch->client, "/" + batch->path, async_request_handler_t::http_patch, slot_options_t(false, false, true, payload.indexOf("\".sv\"") > -1, false, false), nullptr, nullptr, batch->result, NULL);
+        aReq.combined = true;
+
+        // The ETag that was set for the next conditional request should not be taken by the combined request.
+        String etag = batch->client->reqEtag;
+        batch->client->setETag("");
+        asyncRequest(aReq, payload.c_str());
+        batch->client->setETag(etag);
+        batch->slot_addr = aReq.slot_addr;
+    }
+
+    // Send the combined requests when time window was reached and return the results of completed combined requests.
+    void processWriteBatches()
+    {
+        List vec;
+        size_t i = 0;
+        while (i < write_batches.size())
+        {
+            write_batch_t *batch = write_batches[i];
+
+            if (!batch->result)
+            {
+                if (batch->combiner.elapsed() >= combine_window)
+                    sendWriteBatch(batch);
+                i++;
+                continue;
+            }
+
+            if (vec.existed(batch->client->sVec, batch->slot_addr))
+            {
+                i++;
+                continue;
+            }
+
+            write_batches.erase(write_batches.begin() + i);
+            resolveWriteBatch(batch);
+            delete batch->result;
+            delete batch;
+        }
+    }
+
+    void resolveWriteBatch(write_batch_t *batch)
+    {
+        AsyncResult *result = batch->result;
+        bool error = result->isError();
+
+        // The result of silent write is returned only when error.
+        if (batch->silent && !error)
+            return;
+
+        // The response payload is the combined data, the data of each operation is taken from it.
+        String response = result->val[ares_ns::data_payload];
+        JsonReader reader;
+        reader.parse(response);
+
+        List vec;
+        for (size_t i = 0; i < batch->combiner.items.size(); i++)
+        {
+            const WriteCombiner::item_t &item = batch->combiner.items[i];
+            result->setUID(item.uid);
+            result->setPath(item.path);
+
+            if (!error)
+            {
+                String value = item.patch ? String() : reader.get(WriteCombiner::pointer(batch->path, item));
+                result->setPayload(value.length() ? value : item.payload);
+            }
+
+            if (item.aResult && vec.existed(batch->client->rVec, reinterpret_cast<uint32_t>(item.aResult)))
+                copyResult(*item.aResult, *result);
+
+            if (item.cb)
+                item.cb(*result);
+        }
+    }
+
+    void addTransaction(AsyncClientClass &aClient, const String &path, TransactionUpdateCallback update, AsyncResult *aResult, AsyncResultCallback cb, const String &uid)
+    {
+        transaction_t *tx = new transaction_t();
+        tx->client = &aClient;
+        tx->path = path;
+        tx->update = update;
+        tx->aResult = aResult;
+        tx->cb = cb;
+        tx->uid = uid;
+        tx->async = true;
+
+        if (aResult)
+        {
+            // The async result is removed from this list when it was destroyed.
+            List vec;
+            vec.addRemoveList(aClient.rVec, reinterpret_cast<uint32_t>(aResult), true);
+            aResult->rvec_addr = reinterpret_cast<uint32_t>(&(aClient.rVec));
+        }
+
+        if (processTransaction(tx))
+            delete tx;
+        else
+            transactions.push_back(tx);
+    }
+
+    void processTransactions()
+    {
+        size_t i = 0;
+        while (i < transactions.size())
+        {
+            transaction_t *tx = transactions[i];
+            if (processTransaction(tx))
+            {
+                transactions.erase(transactions.begin() + i);
+                delete tx;
+            }
+            else
+                i++;
+        }
+    }
+
+    // Returns true when the transaction was completed.
+    bool processTransaction(transaction_t *tx)
+    {
+        List vec;
+        if (tx->slot_addr && vec.existed(tx->client->sVec, tx->slot_addr))
+            return false;
+
+        tx->slot_addr = 0;
+
+        switch (tx->state)
+        {
+        case transaction_t::state_undefined:
+            sendTransactionRequest(tx, async_request_handler_t::http_get, "");
+            tx->state = transaction_t::state_read;
+            return false;
+
+        case transaction_t::state_read:
+            if (tx->result->isError())
+                return finishTransaction(tx, 0);
+            break;
+
+        case transaction_t::state_write:
+            if (!tx->result->isError() || tx->result->error().code() != FIREBASE_ERROR_HTTP_CODE_PRECONDITION_FAILED || tx->attempts >= FIREBASE_TRANSACTION_MAX_ATTEMPTS)
+                return finishTransaction(tx, 0);
+
+            // The node was changed, wait for the exponential backoff delay with jitter.
+            tx->wait = FIREBASE_TRANSACTION_BACKOFF_MS;
+            for (uint8_t i = 1; i < tx->attempts && tx->wait < FIREBASE_TRANSACTION_MAX_BACKOFF_MS; i++)
+                tx->wait *= 2;
+            if (tx->wait > FIREBASE_TRANSACTION_MAX_BACKOFF_MS)
+                tx->wait = FIREBASE_TRANSACTION_MAX_BACKOFF_MS;
+            tx->wait = tx->wait / 2 + random(tx->wait / 2 + 1);
+            tx->ms = millis();
+            tx->state = transaction_t::state_backoff;
+            return false;
+
+        case transaction_t::state_backoff:
+            if (millis() - tx->ms < tx->wait)
+                return false;
+
+            // The rejected write response without the current data, the node is read again.
+            if (tx->result->val[ares_ns::data_payload].length() == 0 || tx->result->etag().length() == 0)
+            {
+                sendTransactionRequest(tx, async_request_handler_t::http_get, "");
+                tx->state = transaction_t::state_read;
+                return false;
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        // The response of read request or rejected write request is the current data and ETag of node.
+        String next;
+        if (!tx->update || !tx->update(tx->result->val[ares_ns::data_payload], next))
+            return finishTransaction(tx, FIREBASE_ERROR_TRANSACTION_ABORTED);
+
+        tx->attempts++;
+        tx->client->setETag(tx->result->etag());
+        sendTransactionRequest(tx, async_request_handler_t::http_put, next);
+        tx->state = transaction_t::state_write;
+        return false;
+    }
+
+    void sendTransactionRequest(transaction_t *tx, async_request_handler_t::http_request_method method, const String &payload)
+    {
+        if (!tx->result)
+            tx->result = new AsyncResult();
+
+        tx->result->lastError.clearError();
+        async_request_data_t aReq(tx->client, tx->path, method, slot_options_t(false, false, tx->async, payload.indexOf("\".sv\"") > -1, false, false), nullptr, nullptr, tx->result, NULL);
+        aReq.transaction = true;
+        asyncRequest(aReq, payload.c_str());
+        tx->slot_addr = aReq.slot_addr;
+    }
+
+    bool finishTransaction(transaction_t *tx, int code)
+    {
+        AsyncResult *result = tx->result;
+
+        if (code < 0)
+        {
+            result->lastError.setClientError(code);
+            if (!tx->async)
+                tx->client->lastErr.setClientError(code);
+        }
+
+        setTransactionAttempts(&result->rtdbResult, tx->attempts);
+        result->setUID(tx->uid);
+        result->setPath(tx->path);
+
+        List vec;
+        if (tx->aResult && (!tx->async || vec.existed(tx->client->rVec, reinterpret_cast<uint32_t>(tx->aResult))))
+            copyResult(*tx->aResult, *result);
+
+        if (tx->cb)
+            tx->cb(*result);
+
+        delete result;
+        tx->result = nullptr;
+        return true;
+    }
+
+    // Return the get operation from the cached data or send the request and cache its result.
+    bool readCache(async_request_data_t &request, const String &extras)
+    {
+        // The transaction and other internal reads need the current data and ETag of node.
+        if (!read_cache || request.cached || request.transaction || request.tracked || request.method != async_request_handler_t::http_get || request.file || request.opt.sse || request.opt.ota)
+            return false;
+
+        cached_read_t *read = new cached_read_t();
+        read->client = request.aClient;
+        read->key = request.path + extras;
+        read->path = request.path;
+        read->uid = request.uid;
+        read->aResult = request.aResult;
+        read->cb = request.cb;
+        read->async = request.opt.async;
+        read->result = new AsyncResult();
+
+        int index = read_cache->find(read->key);
+        if (index > -1)
+        {
+            const ReadCache::entry_t &entry = read_cache->hit(index);
+            read->result->setPayload(entry.payload);
+            read->result->setETag(entry.etag);
+            setNullETagOption(&read->result->rtdbResult, entry.etag.indexOf("null_etag") > -1);
+            read->result->setPath(request.path);
+            read->result->setUID(request.uid);
+        }
+        else
+        {
+            read_cache->miss_count++;
+            async_request_data_t aReq = request;
+            aReq.aResult = read->result;
+            aReq.cb = NULL;
+            aReq.cached = true;
+            asyncRequest(aReq);
+            read->slot_addr = aReq.slot_addr;
+            request.slot_addr = aReq.slot_addr;
+            read->requested = true;
+        }
+
+        if (!read->async)
+        {
+            if (!read->requested)
+                read->client->lastErr.clearError();
+            completeCachedRead(read);
+            delete read;
+            return true;
+        }
+
+        if (read->aResult)
+        {
+            // The async result is removed from this list when it was destroyed.
+            List vec;
+            vec.addRemoveList(read->client->rVec, reinterpret_cast<uint32_t>(read->aResult), true);
+            read->aResult->rvec_addr = reinterpret_cast<uint32_t>(&(read->client->rVec));
+        }
+
+        cached_reads.push_back(read);
+        return true;
+    }
+
+    void processCachedReads()
+    {
+        List vec;
+        size_t i = 0;
+        while (i < cached_reads.size())
+        {
+            cached_read_t *read = cached_reads[i];
+            if (read->slot_addr && vec.existed(read->client->sVec, read->slot_addr))
+            {
+                i++;
+                continue;
+            }
+            cached_reads.erase(cached_reads.begin() + i);
+            completeCachedRead(read);
+            delete read;
+        }
+    }
+
+    void completeCachedRead(cached_read_t *read)
+    {
+        AsyncResult *result = read->result;
+
+        if (read_cache && read->requested && !result->isError())
+            read_cache->store(read->key, read->path, result->val[ares_ns::data_payload], result->etag());
+
+        List vec;
+        if (read->aResult && (!read->async || vec.existed(read->client->rVec, reinterpret_cast<uint32_t>(read->aResult))))
+            copyResult(*read->aResult, *result);
+
+        if (read->cb)
+            read->cb(*result);
+
+        delete result;
+        read->result = nullptr;
+    }
+
+    // Start reading the child nodes after the start key.
+    void startIterator(AsyncClientClass &aClient, const String &path, DatabaseIterator &iterator, const String &startKey)
+    {
+        iterator.reset();
+        iterator.client = &aClient;
+        iterator.path = path;
+        iterator.last_key = startKey;
+
+        // The iterator is removed from this list when it was destroyed.
+        List vec;
+        vec.addRemoveList(iterators, reinterpret_cast<uint32_t>(&iterator), true);
+        iterator.ivec_addr = reinterpret_cast<uint32_t>(&iterators);
+        processIterator(&iterator);
+    }
+
+#if defined(ENABLE_FS)
+    // Write the child nodes of received pages to the export files.
+    void processExports()
+    {
+        size_t i = 0;
+        while (i < exports.size())
+        {
+            DatabaseExport *exporter = reinterpret_cast<DatabaseExport *>(exports[i]);
+            int code = exporter->write();
+
+            if (code < 0)
+                exporter->err.setClientError(code);
+            else if (exporter->iterator.isError())
+                exporter->err = exporter->iterator.lastError();
+
+            if (code < 0 || exporter->iterator.done())
+            {
+                exporter->finished = true;
+                exporter->evec_addr = 0;
+                exports.erase(exports.begin() + i);
+            }
+            else
+                i++;
+        }
+    }
+
+    void processImports()
+    {
+        size_t i = 0;
+        while (i < imports.size())
+        {
+            DatabaseImport *importer = reinterpret_cast<DatabaseImport *>(imports[i]);
+            processImport(importer);
+
+            if (importer->finished)
+            {
+                importer->ivec_addr = 0;
+                imports.erase(imports.begin() + i);
+            }
+            else
+                i++;
+        }
+    }
+
+    // Move the checkpoint over the completed requests and send the next batches.
+    void processImport(DatabaseImport *importer)
+    {
+        List vec;
+        bool pending = false;
+        for (size_t i = 0; i < importer->batches.size(); i++)
+        {
+            DatabaseImport::batch_t &batch = importer->batches[i];
+            if (!batch.result)
+                continue;
+
+            if (vec.existed(batch.client->sVec, batch.slot_addr))
+            {
+                pending = true;
+                continue;
+            }
+
+            if (batch.result->lastError.code() != 0)
+            {
+                batch.failed = true;
+                if (!importer->isError())
+                    importer->err = batch.result->lastError;
+            }
+            delete batch.result;
+            batch.result = nullptr;
+        }
+        importer->updateCheckpoint();
+
+        while (!importer->isError() && !importer->eof && importer->batches.size() < importer->concurrency)
+        {
+            DatabaseImport::batch_t batch;
+            String payload;
+            int code = importer->readBatch(batch, payload);
+            if (code < 0)
+                importer->err.setClientError(code);
+
+            if (code < 0 || batch.members == 0)
+                break;
+
+            // The least busy async client in the pool.
+            for (size_t i = 0; i < importer->clients.size(); i++)
+            {
+                if (!batch.client || importer->clients[i]->taskCount() < batch.client->taskCount())
+                    batch.client = importer->clients[i];
+            }
+
+            // The batch is sent in the same way as the replayed operation of offline queue (silent, not queued and not combined).
+            batch.result = new AsyncResult();
+            async_request_data_t aReq(batch.client, importer->path, async_request_handler_t::http_patch, slot_options_t(false, false, true, payload.indexOf("\".sv\"") > -1, false, false), nullptr, nullptr, batch.result, NULL);
+            aReq.replay = true;
+            asyncRequest(aReq, payload.c_str());
+            batch.slot_addr = aReq.slot_addr;
+            importer->batches.push_back(batch);
+            pending = true;
+        }
+
+        if (!pending && (importer->eof || importer->isError()))
+        {
+            importer->updateCheckpoint();
+            importer->clearBatches();
+            importer->finished = true;
+        }
+    }
+#endif
+
+    void processIterators()
+    {
+        size_t i = 0;
+        while (i < iterators.size())
+        {
+            DatabaseIterator *iterator = reinterpret_cast<DatabaseIterator *>(iterators[i]);
+            processIterator(iterator);
+
+            // All pages were received.
+            if (iterator->last_page && !iterator->pending())
+            {
+                iterator->ivec_addr = 0;
+                iterators.erase(iterators.begin() + i);
+            }
+            else
+                i++;
+        }
+    }
+
+    // Keep the received page and request the next page when the next page was taken.
+    void processIterator(DatabaseIterator *iterator)
+    {
+        if (iterator->result)
+        {
+            List vec;
+            if (iterator->slot_addr && vec.existed(iterator->client->sVec, iterator->slot_addr))
+                return;
+
+            if (iterator->result->lastError.code() != 0)
+            {
+                iterator->err = iterator->result->lastError;
+                iterator->last_page = true;
+            }
+            else
+                iterator->setNextPage(iterator->result->val[ares_ns::data_payload]);
+
+            delete iterator->result;
+            iterator->result = nullptr;
+            iterator->slot_addr = 0;
+        }
+
+        if (iterator->last_page || iterator->next_ready)
+            return;
+
+        DatabaseOptions options;
+        options.filter.orderBy("$key");
+        if (iterator->last_key.length())
+        {
+            URLUtil uut;
+            options.filter.startAt(uut.encode(iterator->last_key));
+        }
+        options.filter.limitToFirst(iterator->limit());
+
+        iterator->result = new AsyncResult();
+        async_request_data_t aReq(iterator->client, iterator->path, async_request_handler_t::http_get, slot_options_t(false, false, true, false, false, false), &options, nullptr, iterator->result, NULL);
+        aReq.cached = true;
+        asyncRequest(aReq);
+        iterator->slot_addr = aReq.slot_addr;
+    }
+
+    void processStateUpdates()
+    {
+        List vec;
+        size_t i = 0;
+        while (i < state_updates.size())
+        {
+            state_update_t *su = state_updates[i];
+            if (su->slot_addr && vec.existed(su->client->sVec, su->slot_addr))
+            {
+                i++;
+                continue;
+            }
+            state_updates.erase(state_updates.begin() + i);
+            completeStateUpdate(su);
+            delete su;
+        }
+    }
+
+    void completeStateUpdate(state_update_t *su)
+    {
+        AsyncResult *result = su->result;
+
+        if (result->lastError.code() != 0)
+            su->snapshot->clear();
+
+        // The result of silent write is returned only when error.
+        bool returned = !su->async || result->lastError.code() != 0 || result->val[ares_ns::data_payload].length() > 0;
+
+        List vec;
+        if (returned && su->aResult && (!su->async || vec.existed(su->client->rVec, reinterpret_cast<uint32_t>(su->aResult))))
+            copyResult(*su->aResult, *result);
+
+        if (returned && su->cb)
+            su->cb(*result);
+
+        delete result;
+        su->result = nullptr;
+    }
+
+    // Copy the result of internal request, the payload references are changed to the payload of copied result.
+    void copyResult(AsyncResult &dest, const AsyncResult &src)
+    {
+        dest = src;
+        dest.json_reader.clear();
+        setRefPayload(&dest.rtdbResult, &dest.val[ares_ns::data_payload]);
+    }
+
     void addParams(bool hasQueryParams, String &extras, async_request_handler_t::http_request_method method, DatabaseOptions *options, bool isFile)
     {
         URLUtil uut;
@@ -0,0 +1,164 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_STATE_SNAPSHOT_H
+#define DATABASE_STATE_SNAPSHOT_H
+
+#include <Arduino.h>
+#include "./Config.h"
+#include "./core/JsonReader.h"
+
+#if defined(ENABLE_DATABASE)
+
+/**
+ * The last synced JSON object of Realtime database node which is used to send only the changes of new state.
+ */
+class StateSnapshot
+{
+    friend class RealtimeDatabase;
+
+public:
+    StateSnapshot() {}
+
+    /**
+     * Get the changes of the JSON object from the last synced JSON object.
+     *
+     * @param json The new JSON object.
+     * @param patch The multi-path update JSON object of changed values, the removed keys are null.
+     * @return bool Returns false if nothing was changed.
+     *
+     * The patch is the JSON object when the last synced JSON object was not set, the JSON is not object
+     * or the multi-path update is larger than the JSON object.
+     */
+    bool diff(const String &json, String &patch) const
+    {
+        patch.remove(0, patch.length());
+
+        JsonReader n;
+        n.parse(json);
+        if (!synced() || n.type("") != json_value_type_object)
+        {
+            patch = json;
+            return true;
+        }
+
+        JsonReader o;
+        o.parse(snapshot);
+        if (o.type("") != json_value_type_object)
+        {
+            patch = json;
+            return true;
+        }
+
+        patch += '{';
+        compare(o, n, "", "", patch);
+
+        if (patch.length() == 1)
+        {
+            patch.remove(0, patch.length());
+            return false;
+        }
+
+        patch += '}';
+        if (patch.length() >= json.length())
+            patch = json;
+        return true;
+    }
+
+    // Returns true if the last synced JSON object was set.
+    bool synced() const { return snapshot.length() > 0; }
+
+    // The last synced JSON object.
+    String data() const { return snapshot; }
+
+    // Clear the last synced JSON object, the next update will send the whole JSON object.
+    void clear() { snapshot.remove(0, snapshot.length()); }
+
+private:
+    String snapshot;
+
+    // Add the changed and removed values under the JSON pointer to the multi-path update.
+    void compare(const JsonReader &o, const JsonReader &n, const String &ptr, const String &path, String &patch) const
+    {
+        size_t size = n.size(ptr);
+        for (size_t i = 0; i < size; i++)
+        {
+            String k = n.key(ptr, i);
+            String p = ptr + "/" + escape(k);
+            String sub = path.length() ? path + "/" + k : k;
+            json_value_type nt = n.type(p), ot = o.type(p);
+
+            if (nt == json_value_type_object && ot == json_value_type_object && n.size(p) > 0)
+                compare(o, n, p, sub, patch);
+            else if (!equal(o, n, p))
+                add(patch, sub, n.get(p));
+        }
+
+        size = o.size(ptr);
+        for (size_t i = 0; i < size; i++)
+        {
+            String k = o.key(ptr, i);
+            String p = ptr + "/" + escape(k);
+            if (!n.existed(p))
+                add(patch, path.length() ? path + "/" + k : k, "null");
+        }
+    }
+
+    static bool equal(const JsonReader &o, const JsonReader &n, const String &ptr)
+    {
+        size_t len1 = 0, len2 = 0;
+        const char *p1 = o.raw(ptr, len1), *p2 = n.raw(ptr, len2);
+        return p1 && p2 && len1 == len2 && memcmp(p1, p2, len1) == 0;
+    }
+
+    static void add(String &patch, const String &path, const String &value)
+    {
+        if (patch.length() > 1)
+            patch += ',';
+        patch += '"';
+        patch += path;
+        patch += "\":";
+        patch += value;
+    }
+
+    // The JSON pointer escape of path segment.
+    static String escape(const String &seg)
+    {
+        String out;
+        for (size_t i = 0; i < seg.length(); i++)
+        {
+            if (seg[i] == '~')
+                out += "~0";
+            else if (seg[i] == '/')
+                out += "~1";
+            else
+                out += seg[i];
+        }
+        return out;
+    }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,250 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DATABASE_WRITE_COMBINER_H
+#define DATABASE_WRITE_COMBINER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/PathUtil.h"
+#include "./core/JsonReader.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+#if defined(ENABLE_DATABASE)
+
+/**
+ * The pending async set and update operations of an async client that are merged
+ * into a single multi-path update (PATCH) request.
+ *
+ * The data of each operation is kept as the absolute path and value, the later value at
+ * the same path or its parent path replaces the earlier values (last write wins).
+ */
+class WriteCombiner
+{
+    friend class RealtimeDatabase;
+
+public:
+    // The original operation whose result is resolved from the combined request.
+    struct item_t
+    {
+        String path, payload, uid;
+        bool patch = false;
+        AsyncResult *aResult = nullptr;
+        AsyncResultCallback cb = NULL;
+    };
+
+    WriteCombiner() {}
+
+    /**
+     * Add the set or update operation.
+     *
+     * @param item The operation.
+     * @return bool Returns true if the operation was merged, false if the operation should be sent after
+     * the pending operations were sent e.g. the set at root, the update data is not a JSON object or its path
+     * is under the path of pending data.
+     */
+    bool add(const item_t &item)
+    {
+        String path = PathUtil::normalize(item.path);
+
+        std::vector<entry_t> list;
+        if (item.patch)
+        {
+            JsonReader reader;
+            if (!reader.parse(item.payload) || reader.type("") != json_value_type_object || reader.size("") == 0)
+                return false;
+
+            for (size_t i = 0; i < reader.size(""); i++)
+            {
+                String key = reader.key("", i), sub = PathUtil::normalize(key);
+                entry_t e;
+                e.path = path;
+                if (sub.length())
+                {
+                    if (e.path.length())
+                        e.path += '/';
+                    e.path += sub;
+                }
+                if (e.path.length() == 0)
+                    return false;
+                e.value = reader.get("/" + escape(key));
+                list.push_back(e);
+            }
+        }
+        else
+        {
+            if (path.length() == 0)
+                return false;
+            entry_t e;
+            e.path = path;
+            e.value = item.payload;
+            list.push_back(e);
+        }
+
+        // The pending data that the new data is written into can not be merged.
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            for (size_t j = 0; j < entries.size(); j++)
+            {
+                if (entries[j].path.length() < list[i].path.length() && PathUtil::under(list[i].path, entries[j].path))
+                    return false;
+            }
+        }
+
+        for (size_t i = 0; i < list.size(); i++)
+        {
+            // The new data replaces the pending data at the same path or under its path.
+            for (int j = entries.size() - 1; j >= 0; j--)
+            {
+                if (PathUtil::under(entries[j].path, list[i].path))
+                {
+                    data_size -= entries[j].path.length() + entries[j].value.length() + 4;
+                    entries.erase(entries.begin() + j);
+                }
+            }
+            data_size += list[i].path.length() + list[i].value.length() + 4;
+            entries.push_back(list[i]);
+        }
+
+        if (items.size() == 0)
+            ms = millis();
+
+        items.push_back(item);
+        return true;
+    }
+
+    // The number of pending operations.
+    size_t size() const { return items.size(); }
+
+    // The approximate size of combined request payload.
+    size_t length() const { return data_size; }
+
+    // The milliseconds since the first pending operation was added.
+    unsigned long elapsed() const { return items.size() ? millis() - ms : 0; }
+
+    /**
+     * Get the combined request payload.
+     *
+     * @param path The common parent path of pending data.
+     * @param payload The multi-path update JSON object whose keys are relative to the path.
+     */
+    void getPayload(String &path, String &payload) const
+    {
+        path.remove(0, path.length());
+        payload.remove(0, payload.length());
+
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            String parent = entries[i].path;
+            int p = parent.lastIndexOf('/');
+            parent.remove(p > -1 ? p : 0);
+            if (i == 0)
+                path = parent;
+            else
+                commonPath(path, parent);
+        }
+
+        payload.reserve(data_size + 2);
+        payload += '{';
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (i > 0)
+                payload += ',';
+            payload += '"';
+            payload += relPath(path, entries[i].path);
+            payload += "\":";
+            payload += entries[i].value;
+        }
+        payload += '}';
+    }
+
+    /**
+     * Get the JSON pointer of the data in the combined request payload.
+     *
+     * @param path The common parent path of pending data.
+     * @param item The original operation.
+     * @return String The JSON pointer.
+     */
+    static String pointer(const String &path, const item_t &item)
+    {
+        String p = PathUtil::normalize(item.path);
+        return "/" + escape(relPath(path, p));
+    }
+
+    void clear()
+    {
+        entries.clear();
+        items.clear();
+        data_size = 0;
+        ms = 0;
+    }
+
+private:
+    struct entry_t
+    {
+        String path, value;
+    };
+
+    std::vector<entry_t> entries;
+    std::vector<item_t> items;
+    size_t data_size = 0;
+    unsigned long ms = 0;
+
+    static void commonPath(String &path, const String &other)
+    {
+        size_t len = 0;
+        for (size_t i = 0; i <= path.length() && i <= other.length(); i++)
+        {
+            bool end1 = i == path.length() || path[i] == '/', end2 = i == other.length() || other[i] == '/';
+            if (end1 && end2)
+                len = i;
+            if (i == path.length() || i == other.length() || path[i] != other[i])
+                break;
+        }
+        path.remove(len);
+    }
+
+    static String relPath(const String &parent, const String &path) { return path.substring(parent.length() ? parent.length() + 1 : 0); }
+
+    // The JSON pointer escape of path segment.
+    static String escape(const String &seg)
+    {
+        String out;
+        for (size_t i = 0; i < seg.length(); i++)
+        {
+            if (seg[i] == '~')
+                out += "~0";
+            else if (seg[i] == '/')
+                out += "~1";
+            else
+                out += seg[i];
+        }
+        return out;
+    }
+};
+
+#endif
+
+#endif
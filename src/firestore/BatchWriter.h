@@ -0,0 +1,143 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef FIRESTORE_BATCH_WRITER_H
+#define FIRESTORE_BATCH_WRITER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/JsonReader.h"
+#include "./core/AsyncResult/AsyncResult.h"
+
+#if defined(ENABLE_FIRESTORE)
+
+namespace Firestore
+{
+    /**
+     * The pending writes of an async client that are sent in a single batchWrite request.
+     *
+     * The writes of batchWrite request are not applied atomically and not in order, the status of each write
+     * is returned in the response and resolved to the result of its write operation.
+     */
+    class BatchWriter
+    {
+        friend class Documents;
+
+    public:
+        // The write operation whose result is resolved from the batchWrite response.
+        struct item_t
+        {
+            String write, uid;
+            uint8_t attempts = 0;
+            AsyncResult *aResult = nullptr;
+            AsyncResultCallback cb = NULL;
+        };
+
+        BatchWriter() {}
+
+        // Add the write operation.
+        void add(const item_t &item)
+        {
+            if (items.size() == 0)
+                ms = millis();
+            data_size += item.write.length() + 1;
+            items.push_back(item);
+        }
+
+        // The number of pending writes.
+        size_t size() const { return items.size(); }
+
+        // The approximate size of batchWrite request payload.
+        size_t length() const { return data_size; }
+
+        // The milliseconds since the first pending write was added.
+        unsigned long elapsed() const { return items.size() ? millis() - ms : 0; }
+
+        /**
+         * Get the batchWrite request payload.
+         *
+         * @param payload The BatchWriteRequest object e.g. {"writes":[...]}.
+         */
+        void getPayload(String &payload) const
+        {
+            payload.remove(0, payload.length());
+            payload.reserve(data_size + 12);
+            payload += FPSTR("{\"writes\":[");
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                if (i > 0)
+                    payload += ',';
+                payload += items[i].write;
+            }
+            payload += FPSTR("]}");
+        }
+
+        /**
+         * Get the status of the write from the batchWrite response.
+         *
+         * @param reader The JsonReader of BatchWriteResponse object.
+         * @param index The index of write.
+         * @param message The status message.
+         * @return int The status code (google.rpc.Code) or 0 when the write was applied.
+         */
+        static int status(const JsonReader &reader, size_t index, String &message)
+        {
+            String path = FPSTR("/status/");
+            path += String(index);
+            int code = reader.get(path + FPSTR("/code")).toInt();
+            if (code)
+            {
+                message = reader.get(path + FPSTR("/message"));
+                if (message.length() > 1 && message[0] == '"')
+                    message = message.substring(1, message.length() - 1);
+            }
+            return code;
+        }
+
+        /**
+         * Check if the failed write can be applied when it was sent again.
+         *
+         * @param code The status code (google.rpc.Code).
+         * @return bool Returns true for DEADLINE_EXCEEDED, RESOURCE_EXHAUSTED, ABORTED, INTERNAL and UNAVAILABLE.
+         */
+        static bool retryable(int code) { return code == 4 || code == 8 || code == 10 || code == 13 || code == 14; }
+
+        void clear()
+        {
+            items.clear();
+            data_size = 0;
+            ms = 0;
+        }
+
+    private:
+        std::vector<item_t> items;
+        size_t data_size = 0;
+        unsigned long ms = 0;
+    };
+}
+
+#endif
+
+#endif
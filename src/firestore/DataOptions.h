@@ -56,6 +56,7 @@ enum firebase_firestore_request_type
     firebase_firestore_request_type_create_composite_index,
     firebase_firestore_request_type_create_field_index,
     firebase_firestore_request_type_manage_database,
+    firebase_firestore_request_type_listen,
 
     firebase_firestore_request_type_get_doc = 300,
     firebase_firestore_request_type_list_doc,
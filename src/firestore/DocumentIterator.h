@@ -0,0 +1,361 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef FIRESTORE_DOCUMENT_ITERATOR_H
+#define FIRESTORE_DOCUMENT_ITERATOR_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/List.h"
+#include "./core/URL.h"
+#include "./core/JsonReader.h"
+#include "./core/AsyncResult/AsyncResult.h"
+#include "./firestore/DataOptions.h"
+#include "./firestore/DocumentReader.h"
+
+#if defined(ENABLE_FIRESTORE)
+
+class AsyncClientClass;
+
+namespace Firestore
+{
+    class Documents;
+
+    /**
+     * The iterator of the documents (Documents::list), the collection ids (Documents::listCollectionIds)
+     * or the query results (Documents::runQuery) which are read in pages.
+     *
+     * The next page is requested from Documents::loop while the current page is iterated,
+     * then only the current page and the next page are kept in memory.
+     */
+    class DocumentIterator
+    {
+        friend class Documents;
+
+    public:
+        /**
+         * @param pageSize The number of documents or collection ids to read in one request.
+         */
+        explicit DocumentIterator(uint16_t pageSize = 50) { page_size = pageSize > 0 ? pageSize : 1; }
+        DocumentIterator(const DocumentIterator &) = delete;
+        DocumentIterator &operator=(const DocumentIterator &) = delete;
+
+        ~DocumentIterator()
+        {
+            delete result;
+            if (ivec_addr > 0)
+            {
+                std::vector<uint32_t> *iVec = reinterpret_cast<std::vector<uint32_t> *>(ivec_addr);
+                List vec;
+                vec.addRemoveList(*iVec, reinterpret_cast<uint32_t>(this), false);
+            }
+        }
+
+        /**
+         * Move to the next document or collection id.
+         *
+         * @return bool Returns true if the document or collection id is available, false when the next page was not read yet or all items were iterated.
+         */
+        bool next()
+        {
+            if (index + 1 < (int)size())
+            {
+                index++;
+                return true;
+            }
+
+            if (!next_ready)
+                return false;
+
+            // Take the next page, the page after it will be requested in Documents::loop.
+            current = next_page;
+            next_page.remove(0, next_page.length());
+            next_ready = false;
+            setPage();
+
+            if (index + 1 < (int)size())
+            {
+                index++;
+                return true;
+            }
+            return false;
+        }
+
+        // The current document of Documents::iterate and Documents::iterateQuery.
+        DocumentView document() const { return index > -1 && type != iterator_type_collection_ids ? reader.document(index) : DocumentView(); }
+
+        // The current collection id of Documents::iterateCollectionIds.
+        TextView collectionId() const
+        {
+            if (index < 0 || type != iterator_type_collection_ids)
+                return TextView();
+            size_t len = 0;
+            const char *p = ids.raw("/collectionIds/" + String(index), len);
+            return p && len > 1 ? TextView(p + 1, len - 2) : TextView();
+        }
+
+        // Returns true when all items were iterated or the iteration was stopped and the current page was iterated.
+        bool done() const { return (last_page || stopped) && !pending() && !next_ready && index + 1 >= (int)size(); }
+
+        /**
+         * Stop reading the next pages e.g. when the iteration loop was broken.
+         *
+         * The items of current page and the page that was already received can still be iterated.
+         * The request that is in progress is not cancelled but its page is ignored.
+         */
+        void stop() { stopped = true; }
+
+        // Returns true when the error occurred, the items that were read can still be iterated.
+        bool isError() { return err.isError() || err.code() != 0; }
+
+        // The error of page request.
+        FirebaseError lastError() const { return err; }
+
+        // The number of documents or collection ids that were read.
+        uint32_t count() const { return read_count; }
+
+    private:
+        enum iterator_type
+        {
+            iterator_type_list,
+            iterator_type_collection_ids,
+            iterator_type_query
+        };
+
+        // The raw Firestore typed value e.g. {"integerValue":"5"} of the cursor.
+        struct raw_value_t
+        {
+            String s;
+            const char *val() { return s.c_str(); }
+        };
+
+        iterator_type type = iterator_type_list;
+        uint16_t page_size = 50;
+        uint32_t ivec_addr = 0, slot_addr = 0, read_count = 0;
+        AsyncClientClass *client = nullptr;
+        AsyncResult *result = nullptr;
+        Parent parent;
+        // The collection id (list) or the document path (listCollectionIds and runQuery).
+        String path;
+        ListDocumentsOptions list_options;
+        ListCollectionIdsOptions ids_options;
+#if defined(ENABLE_FIRESTORE_QUERY)
+        StructuredQuery query;
+        // The field paths of the query order, the last one is __name__.
+        std::vector<String> order;
+        // The startAt cursor values of next page.
+        std::vector<String> cursor;
+        // The remaining number of documents of the query limit or -1 for no limit.
+        int32_t remaining = -1;
+        uint16_t page_limit = 0;
+#endif
+        String page_token;
+        String current, next_page;
+        DocumentReader reader;
+        JsonReader ids;
+        int index = -1;
+        bool next_ready = false, last_page = false, stopped = false;
+        FirebaseError err;
+
+        bool pending() const { return result != nullptr; }
+
+        size_t size() const { return type == iterator_type_collection_ids ? ids.size("/collectionIds") : reader.size(); }
+
+        void reset()
+        {
+            delete result;
+            result = nullptr;
+            slot_addr = 0;
+            read_count = 0;
+#if defined(ENABLE_FIRESTORE_QUERY)
+            order.clear();
+            cursor.clear();
+            remaining = -1;
+            page_limit = 0;
+#endif
+            page_token.remove(0, page_token.length());
+            current.remove(0, current.length());
+            next_page.remove(0, next_page.length());
+            reader.clear();
+            ids.clear();
+            index = -1;
+            next_ready = false;
+            last_page = false;
+            stopped = false;
+            err = FirebaseError();
+        }
+
+        // Set the page size and page token of the next list request.
+        void setListPage()
+        {
+            URLUtil uut;
+            if (type == iterator_type_list)
+                list_options.pageSize(page_size).pageToken(uut.encode(page_token));
+            else
+            {
+                ids_options.pageSize(page_size);
+                if (page_token.length())
+                    ids_options.pageToken(page_token);
+            }
+        }
+
+#if defined(ENABLE_FIRESTORE_QUERY)
+        // Read the query order and limit, the documents are ordered by __name__ at last to make the cursor unique.
+        void setQuery(const StructuredQuery &query)
+        {
+            this->query = query;
+
+            String json = query.c_str();
+            JsonReader q;
+            q.parse(json);
+
+            String direction;
+            bool has_name = false;
+            for (size_t i = 0; i < q.size("/orderBy"); i++)
+            {
+                String fieldPath = unquote(q.get("/orderBy/" + String(i) + "/field/fieldPath"));
+                direction = unquote(q.get("/orderBy/" + String(i) + "/direction"));
+                has_name |= fieldPath == "__name__";
+                order.push_back(fieldPath);
+            }
+
+            // The implicit __name__ order has the same direction as the last order.
+            if (!has_name)
+            {
+                order.push_back("__name__");
+                this->query.orderBy(Order(FieldReference("__name__"), direction == "DESCENDING" ? FilterSort::DESCENDING : FilterSort::ASCENDING));
+            }
+
+            if (q.existed("/limit"))
+                remaining = q.get("/limit").toInt();
+            last_page = remaining == 0;
+        }
+
+        // Set the limit and startAt cursor of the next query request.
+        void setQueryPage(StructuredQuery &q)
+        {
+            q = query;
+            page_limit = remaining > -1 && remaining < page_size ? remaining : page_size;
+            q.limit(page_limit);
+
+            if (cursor.size())
+            {
+                // The offset was applied to the first page.
+                q.offset(0);
+                Cursor c;
+                c.before(false);
+                for (size_t i = 0; i < cursor.size(); i++)
+                {
+                    raw_value_t v;
+                    v.s = cursor[i];
+                    c.values(Values::Value(v));
+                }
+                q.startAt(c);
+            }
+        }
+#endif
+
+        // Keep the received page as the next page.
+        void setNextPage(const String &payload)
+        {
+            size_t size = 0;
+            if (type == iterator_type_collection_ids)
+            {
+                JsonReader page;
+                page.parse(payload);
+                size = page.size("/collectionIds");
+                page_token = unquote(page.get("/nextPageToken"));
+                last_page = page_token.length() == 0;
+            }
+            else
+            {
+                DocumentReader page;
+                page.parse(payload);
+                size = page.size();
+
+                if (type == iterator_type_list)
+                {
+                    page_token = page.nextPageToken().toString();
+                    last_page = page_token.length() == 0;
+                }
+#if defined(ENABLE_FIRESTORE_QUERY)
+                else
+                {
+                    if (remaining > -1)
+                        remaining -= size < (size_t)remaining ? size : remaining;
+                    last_page = size < page_limit || remaining == 0;
+
+                    // The cursor is the order field values of the last document.
+                    cursor.clear();
+                    if (size > 0)
+                    {
+                        DocumentView doc = page.document(size - 1);
+                        for (size_t i = 0; i < order.size(); i++)
+                        {
+                            if (order[i] == "__name__")
+                                cursor.push_back("{\"referenceValue\":\"" + copy(doc.name()) + "\"}");
+                            else
+                                cursor.push_back(copy(doc.get(order[i].c_str()).raw()));
+                        }
+                    }
+                }
+#endif
+            }
+
+            // The empty page that is not the last page is skipped.
+            if (size > 0)
+            {
+                next_page = payload;
+                next_ready = true;
+            }
+        }
+
+        void setPage()
+        {
+            if (type == iterator_type_collection_ids)
+                ids.parse(current);
+            else
+                reader.parse(current);
+            index = -1;
+            read_count += size();
+        }
+
+        // The characters of the view as they are in the payload (not unescaped).
+        static String copy(const TextView &v)
+        {
+            String s;
+            s.reserve(v.length());
+            for (size_t i = 0; i < v.length(); i++)
+                s += v.data()[i];
+            return s;
+        }
+
+        static String unquote(const String &s) { return s.length() > 1 && s[0] == '"' ? TextView(s.c_str() + 1, s.length() - 2).toString() : String(); }
+    };
+}
+
+#endif
+
+#endif
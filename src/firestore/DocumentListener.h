@@ -0,0 +1,309 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef FIRESTORE_DOCUMENT_LISTENER_H
+#define FIRESTORE_DOCUMENT_LISTENER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/List.h"
+#include "./core/JSON.h"
+#include "./core/URL.h"
+#include "./core/PathUtil.h"
+#include "./core/JsonReader.h"
+#include "./core/AsyncClient/AsyncClient.h"
+#include "./firestore/DataOptions.h"
+#include "./firestore/DocumentReader.h"
+
+#if defined(ENABLE_FIRESTORE)
+
+namespace Firestore
+{
+    class Documents;
+
+    /**
+     * The target (the documents or the query) of Firestore Listen channel and its session states.
+     *
+     * The Listen method is not available in the REST API, the changes are read from the WebChannel
+     * (the long-polling HTTP transport of Firestore Web SDK) at /google.firestore.v1.Firestore/Listen/channel.
+     * The session is created by the POST request that adds the target, then the changes are read from the GET request
+     * (back channel) which is sent again from Documents::loop when it was closed by server.
+     *
+     * The session id from the X-HTTP-Session-Id header of the session response is sent as the gsessionid parameter
+     * of the following requests, which routes them to the server that keeps the session.
+     *
+     * The resume token of the target is kept, when the session was created again, the target is added with the
+     * resume token and only the changes after it are sent.
+     */
+    class DocumentListener
+    {
+        friend class Documents;
+
+    public:
+        /**
+         * @param targetId The id of the listen target.
+         */
+        explicit DocumentListener(int32_t targetId = 1) { target_id = targetId > 0 ? targetId : 1; }
+        DocumentListener(const DocumentListener &) = delete;
+        DocumentListener &operator=(const DocumentListener &) = delete;
+
+        ~DocumentListener()
+        {
+            stop();
+            List vec;
+            vec.addRemoveList(list(), reinterpret_cast<uint32_t>(this), false);
+        }
+
+        /**
+         * Add the document to listen.
+         *
+         * @param documentPath The relative path of document e.g. "users/alice".
+         * @return DocumentListener& The reference of this object.
+         */
+        DocumentListener &addDocument(const String &documentPath)
+        {
+            documents.push_back(documentPath);
+            return *this;
+        }
+
+#if defined(ENABLE_FIRESTORE_QUERY)
+        /**
+         * Set the query to listen, the documents that were added are not listened.
+         *
+         * @param documentPath The relative path of the parent document of the query.
+         * @param query The StructuredQuery object.
+         * @return DocumentListener& The reference of this object.
+         */
+        DocumentListener &query(const String &documentPath, const StructuredQuery &query)
+        {
+            query_path = documentPath;
+            query_json = query.c_str();
+            return *this;
+        }
+#endif
+
+        /**
+         * Stop listening, the request that is in progress is cancelled.
+         *
+         * The listener can be started again with Documents::listen, the resume token is kept.
+         */
+        void stop()
+        {
+            if (client && slot_addr)
+                client->stopAsync(uid);
+            slot_addr = 0;
+            stopped = true;
+        }
+
+        // Returns true when the back channel request was sent and the changes are being read.
+        bool isListening() const { return !stopped && slot_addr && !handshake; }
+
+        // The resume token of the target from the last target change.
+        String resumeToken() const { return token; }
+
+        /**
+         * Set the resume token of the target e.g. the token that was kept before the device was restarted.
+         *
+         * @param token The resume token. Should be set before Documents::listen.
+         */
+        void setResumeToken(const String &token) { this->token = token; }
+
+        // The number of listen responses that were received.
+        uint32_t count() const { return read_count; }
+
+    private:
+        std::vector<String> documents;
+        String query_path, query_json;
+        String token, sid, gsessionid, uid;
+        int32_t target_id = 1;
+        // The id of the last WebChannel message.
+        int32_t aid = 0;
+        // The number of messages that were received from the current request.
+        uint32_t received = 0;
+        uint32_t rid = 0, owner = 0, slot_addr = 0, read_count = 0;
+        unsigned long retry_ms = 0, retry_delay = 0;
+        bool stopped = true, handshake = false;
+        AsyncClientClass *client = nullptr;
+        AsyncResultCallback cb = NULL;
+        Parent parent;
+
+        // The listeners that were started, the WebChannel messages are dispatched to the listeners in this list only.
+        static std::vector<uint32_t> &list()
+        {
+            static std::vector<uint32_t> vec;
+            return vec;
+        }
+
+        // Set the retry delay after the request failed, the delay is doubled up to 64 seconds.
+        void setRetry()
+        {
+            retry_delay = retry_delay == 0 ? 1000 : (retry_delay < 64000 ? retry_delay * 2 : 64000);
+            retry_ms = millis();
+        }
+
+        // Remove the session, the new session will be created.
+        void clearSession()
+        {
+            sid.remove(0, sid.length());
+            gsessionid.remove(0, gsessionid.length());
+        }
+
+        static String unquote(const String &s) { return s.length() > 1 && s[0] == '"' ? TextView(s.c_str() + 1, s.length() - 2).toString() : String(); }
+
+        // The ListenRequest that adds the target.
+        String listenRequest(const String &database) const
+        {
+            JSONUtil jut;
+            String target, content;
+            if (query_json.length())
+            {
+                String path = database + FPSTR("/documents");
+                if (PathUtil::normalize(query_path).length())
+                    path += '/' + PathUtil::normalize(query_path);
+                jut.addObject(content, FPSTR("parent"), path, true);
+                jut.addObject(content, FPSTR("structuredQuery"), query_json, false, true);
+                jut.addObject(target, FPSTR("query"), content, false);
+            }
+            else
+            {
+                String names;
+                for (size_t i = 0; i < documents.size(); i++)
+                    jut.addArray(names, database + FPSTR("/documents/") + PathUtil::normalize(documents[i]), true, i == documents.size() - 1);
+                jut.addObject(content, FPSTR("documents"), names.length() ? names : String(FPSTR("[]")), false, true);
+                jut.addObject(target, FPSTR("documents"), content, false);
+            }
+            jut.addObject(target, FPSTR("targetId"), String(target_id), false);
+            if (token.length())
+                jut.addObject(target, FPSTR("resumeToken"), token, true);
+            target += '}';
+
+            String request;
+            jut.addObject(request, FPSTR("database"), database, true);
+            jut.addObject(request, FPSTR("addTarget"), target, false, true);
+            return request;
+        }
+
+        // The query parameters of the session request (handshake) or the back channel request.
+        String params(const String &database, bool backChannel) const
+        {
+            URLUtil uut;
+            String str = FPSTR("?database=");
+            str += uut.encode(database);
+            str += FPSTR("&VER=8");
+            if (backChannel)
+            {
+                str += FPSTR("&RID=rpc&SID=");
+                str += uut.encode(sid);
+                str += FPSTR("&CI=0&AID=");
+                str += String(aid);
+                str += FPSTR("&TYPE=xmlhttp");
+            }
+            else
+            {
+                str += FPSTR("&RID=");
+                str += String(rid);
+                str += FPSTR("&CVER=22&%24httpHeaders=");
+                String headers = FPSTR("google-cloud-resource-prefix:");
+                headers += database;
+                headers += FPSTR("\r\nx-goog-request-params:database=");
+                headers += uut.encode(database);
+                headers += FPSTR("\r\nX-HTTP-Session-Id:gsessionid\r\n");
+                str += uut.encode(headers);
+            }
+            if (gsessionid.length())
+            {
+                str += FPSTR("&gsessionid=");
+                str += uut.encode(gsessionid);
+            }
+            str += FPSTR("&zx=");
+            str += String(millis());
+            str += FPSTR("&t=1");
+            return str;
+        }
+
+        // The form data of the session request.
+        String payload(const String &database) const
+        {
+            URLUtil uut;
+            String str = FPSTR("count=1&ofs=0&req0___data__=");
+            str += uut.encode(listenRequest(database));
+            return str;
+        }
+
+        /**
+         * Read the WebChannel message e.g. [3,[{"targetChange":{...}}]].
+         *
+         * @param message The message.
+         * @param response The ListenResponse object e.g. {"documentChange":{...}}.
+         * @return bool Returns true when the message is the ListenResponse.
+         */
+        bool parseMessage(const String &message, String &response)
+        {
+            JsonReader reader;
+            if (!reader.parse(message) || reader.type("") != json_value_type_array)
+                return false;
+
+            aid = reader.get("/0").toInt();
+            received++;
+
+            // The session control messages e.g. ["c","<session id>",...], ["noop"] and ["close"].
+            if (reader.type("/1/0") == json_value_type_string)
+            {
+                String type = unquote(reader.get("/1/0"));
+                if (type == "c")
+                    sid = unquote(reader.get("/1/1"));
+                else if (type == "close" || type == "stop")
+                    clearSession();
+                return false;
+            }
+
+            if (reader.type("/1/0") != json_value_type_object)
+                return false;
+
+            response = reader.get("/1/0");
+            read_count++;
+            retry_delay = 0;
+
+            // The resume token of all targets (no target ids) or this target.
+            if (reader.existed("/1/0/targetChange/resumeToken"))
+            {
+                size_t size = reader.size("/1/0/targetChange/targetIds");
+                bool match = size == 0;
+                for (size_t i = 0; i < size; i++)
+                {
+                    if (reader.get("/1/0/targetChange/targetIds/" + String(i)).toInt() == target_id)
+                        match = true;
+                }
+                if (match)
+                    token = unquote(reader.get("/1/0/targetChange/resumeToken"));
+            }
+            return true;
+        }
+    };
+}
+
+#endif
+
+#endif
@@ -0,0 +1,795 @@
+/**
+ * Created October 18, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2024 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef FIRESTORE_DOCUMENT_READER_H
+#define FIRESTORE_DOCUMENT_READER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./Config.h"
+#include "./core/JsonReader.h"
+#include "./firestore/Values.h"
+
+#if defined(ENABLE_FIRESTORE)
+
+namespace Firestore
+{
+    class DocumentReader;
+
+    /**
+     * The characters of the string or number in the response payload without copying.
+     *
+     * The escaped characters of the string are kept as they are in the payload.
+     */
+    class TextView : public Printable
+    {
+    public:
+        TextView() {}
+
+        TextView(const char *data, size_t len) : p(data), n(len) {}
+
+        // The pointer to the first character in the payload (not null terminated).
+        const char *data() const { return p; }
+
+        size_t length() const { return n; }
+
+        bool empty() const { return n == 0; }
+
+        /**
+         * Compare the characters with the null terminated string.
+         *
+         * @param s The string to compare.
+         * @return bool Returns true if they are equal.
+         */
+        bool equals(const char *s) const { return s && strlen(s) == n && (n == 0 || strncmp(p, s, n) == 0); }
+
+        /**
+         * Get the unescaped copy of the characters.
+         *
+         * @return String The copy of the characters.
+         */
+        String toString() const
+        {
+            String out;
+            out.reserve(n);
+            for (size_t i = 0; i < n; i++)
+            {
+                if (p[i] != '\\' || i + 1 >= n)
+                {
+                    out += p[i];
+                    continue;
+                }
+
+                char c = p[++i];
+                if (c == 'u' && i + 4 < n)
+                {
+                    uint32_t cp = hex4(p + i + 1);
+                    i += 4;
+                    // The surrogate pair.
+                    if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 < n && p[i + 1] == '\\' && p[i + 2] == 'u')
+                    {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (hex4(p + i + 3) - 0xDC00);
+                        i += 6;
+                    }
+                    utf8(out, cp);
+                }
+                else
+                    out += c == 'n' ? '\n' : c == 'r' ? '\r' : c == 't' ? '\t' : c == 'b' ? '\b' : c == 'f' ? '\f' : c;
+            }
+            return out;
+        }
+
+        size_t printTo(Print &pr) const override { return n ? pr.write((const uint8_t *)p, n) : 0; }
+
+    private:
+        const char *p = nullptr;
+        size_t n = 0;
+
+        static uint32_t hex4(const char *s)
+        {
+            uint32_t v = 0;
+            for (int i = 0; i < 4; i++)
+                v = (v << 4) | (s[i] >= 'a' ? s[i] - 'a' + 10 : s[i] >= 'A' ? s[i] - 'A' + 10 : s[i] - '0');
+            return v;
+        }
+
+        static void utf8(String &out, uint32_t cp)
+        {
+            if (cp < 0x80)
+                out += (char)cp;
+            else if (cp < 0x800)
+            {
+                out += (char)(0xC0 | (cp >> 6));
+                out += (char)(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000)
+            {
+                out += (char)(0xE0 | (cp >> 12));
+                out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                out += (char)(0x80 | (cp & 0x3F));
+            }
+            else
+            {
+                out += (char)(0xF0 | (cp >> 18));
+                out += (char)(0x80 | ((cp >> 12) & 0x3F));
+                out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                out += (char)(0x80 | (cp & 0x3F));
+            }
+        }
+    };
+
+    /**
+     * The typed Firestore value e.g. {"integerValue":"5"} in the response payload.
+     */
+    class ValueView
+    {
+        friend class DocumentReader;
+        friend class DocumentView;
+
+    public:
+        ValueView() {}
+
+        // Check if the value exists.
+        bool exists() const { return index > -1; }
+
+        /**
+         * Get the type of value.
+         *
+         * @return firestore_const_key_type The firestore_const_key_type enum or firestore_const_key_maxType if the value does not exist.
+         */
+        firestore_const_key_type type() const;
+
+        bool isNull() const { return type() == firestore_const_key_nullValue; }
+
+        bool toBool() const;
+
+        /**
+         * Get the integer value.
+         *
+         * @return int64_t The integerValue or the truncated doubleValue.
+         */
+        int64_t toInt() const;
+
+        /**
+         * Get the double value.
+         *
+         * @return double The doubleValue (included NaN and Infinity) or integerValue.
+         */
+        double toDouble() const;
+
+        /**
+         * Get the characters of stringValue, timestampValue, bytesValue (base64 string) or referenceValue without copying.
+         *
+         * @return TextView The characters in the payload.
+         */
+        TextView toText() const;
+
+        /**
+         * Get the UNIX time of timestampValue.
+         *
+         * @param seconds The seconds since epoch.
+         * @param nanos The fractions of a second in nanoseconds.
+         * @return bool Returns true if the value is the valid RFC 3339 timestamp.
+         */
+        bool toTimestamp(int64_t &seconds, uint32_t &nanos) const;
+
+        /**
+         * Decode the bytesValue to the buffer.
+         *
+         * @param buf The buffer to store the bytes or nullptr to get the length of bytes.
+         * @param size The size of buffer.
+         * @return size_t The number of bytes or 0 if the value is not bytesValue or the buffer is too small.
+         */
+        size_t toBytes(uint8_t *buf, size_t size) const;
+
+        // The latitude of geoPointValue.
+        double latitude() const;
+
+        // The longitude of geoPointValue.
+        double longitude() const;
+
+        /**
+         * Get the number of arrayValue elements or mapValue fields.
+         *
+         * @return size_t The number of elements or fields.
+         */
+        size_t size() const;
+
+        /**
+         * Get the arrayValue element or the mapValue field value.
+         *
+         * @param index The index of element or field.
+         * @return ValueView The element or field value.
+         */
+        ValueView at(size_t index) const;
+
+        /**
+         * Get the mapValue field name.
+         *
+         * @param index The index of field.
+         * @return TextView The field name.
+         */
+        TextView key(size_t index) const;
+
+        /**
+         * Get the value of the mapValue field.
+         *
+         * @param fieldPath The field path e.g. "a.b.c", the field name that contains dot should be quoted with backticks e.g. "a.`b.c`".
+         * @return ValueView The field value.
+         */
+        ValueView get(const char *fieldPath) const;
+
+        // The raw JSON of the value e.g. {"integerValue":"5"}.
+        TextView raw() const;
+
+    private:
+        const DocumentReader *reader = nullptr;
+        int index = -1;
+
+        ValueView(const DocumentReader *reader, int index) : reader(reader), index(index) {}
+
+        // The index of JSON value of the typed value.
+        int typed(firestore_const_key_type t) const;
+    };
+
+    /**
+     * The document in the response payload.
+     */
+    class DocumentView
+    {
+        friend class DocumentReader;
+
+    public:
+        DocumentView() {}
+
+        /**
+         * Check if the document exists.
+         *
+         * @return bool Returns false for the missing document of batchGet result, the deleted or removed document of
+         * Documents::listen response or the document index is out of range.
+         */
+        bool exists() const { return index > -1; }
+
+        // The resource name of the document e.g. "projects/{projectId}/databases/{databaseId}/documents/{document_path}".
+        TextView name() const;
+
+        // The last segment of the document resource name.
+        TextView id() const;
+
+        TextView createTime() const;
+
+        TextView updateTime() const;
+
+        // The time at which the document was read (runQuery and batchGet results).
+        TextView readTime() const;
+
+        // The number of top level fields.
+        size_t size() const;
+
+        /**
+         * Get the top level field name.
+         *
+         * @param index The index of field.
+         * @return TextView The field name.
+         */
+        TextView key(size_t index) const;
+
+        /**
+         * Get the top level field value.
+         *
+         * @param index The index of field.
+         * @return ValueView The field value.
+         */
+        ValueView at(size_t index) const;
+
+        /**
+         * Get the field value.
+         *
+         * @param fieldPath The field path e.g. "a.b.c", the field name that contains dot should be quoted with backticks e.g. "a.`b.c`".
+         * @return ValueView The field value.
+         */
+        ValueView get(const char *fieldPath) const;
+
+    private:
+        const DocumentReader *reader = nullptr;
+        // The document object, its resource name and the result element (runQuery and batchGet) indices.
+        int index = -1, name_index = -1, elem_index = -1;
+    };
+
+    /**
+     * The single-pass decoder of the Firestore document responses e.g. the results of Documents::get, Documents::list,
+     * Documents::batchGet, Documents::runQuery, the streamed element of runQuery and batchGet results, the Documents::listen response
+     * and the document that was created or updated.
+     *
+     * The documents, field names and values are the views into the payload without copying.
+     *
+     * The payload should not be changed or freed while the values are read.
+     */
+    class DocumentReader
+    {
+        friend class ValueView;
+        friend class DocumentView;
+
+    public:
+        DocumentReader() {}
+
+        /**
+         * Parse the response payload.
+         *
+         * @param json The response payload.
+         * @param len The length of response payload.
+         * @return bool Returns true if the payload is valid JSON.
+         */
+        bool parse(const char *json, size_t len)
+        {
+            clear();
+            if (!reader.parse(json, len))
+                return false;
+
+            const JsonReader::token_t &root = reader.tape[0];
+            if (root.type == json_value_type_array)
+            {
+                // The runQuery and batchGet results.
+                for (uint32_t i = 1; i < root.next; i = reader.tape[i].next)
+                    addResult(i);
+            }
+            else if (root.type == json_value_type_object)
+            {
+                int list = member(0, "documents");
+                token_index = member(0, "nextPageToken");
+                if (list > -1 && reader.tape[list].type == json_value_type_array)
+                {
+                    for (uint32_t i = list + 1; i < reader.tape[list].next; i = reader.tape[i].next)
+                        addDocument(i);
+                }
+                else if (list == -1 && (member(0, "fields") > -1 || member(0, "name") > -1))
+                    addDocument(0);
+                // The streamed element of runQuery and batchGet results.
+                else if (list == -1)
+                    addResult(0);
+            }
+            return true;
+        }
+
+        bool parse(const char *json) { return parse(json, json ? strlen(json) : 0); }
+
+        bool parse(const String &json) { return parse(json.c_str(), json.length()); }
+
+        /**
+         * Remove the parsed documents.
+         */
+        void clear()
+        {
+            reader.clear();
+            docs.clear();
+            token_index = -1;
+            transaction_index = -1;
+        }
+
+        /**
+         * Check if the payload was parsed successfully.
+         *
+         * @return bool Returns true if the payload was parsed.
+         */
+        bool isValid() const { return reader.isValid(); }
+
+        /**
+         * Get the number of documents.
+         *
+         * @return size_t The number of documents included the missing documents of batchGet result.
+         */
+        size_t size() const { return docs.size(); }
+
+        /**
+         * Get the document.
+         *
+         * @param index The index of document.
+         * @return DocumentView The document.
+         */
+        DocumentView document(size_t index) const
+        {
+            DocumentView doc;
+            if (index < docs.size())
+            {
+                doc = docs[index];
+                doc.reader = this;
+            }
+            return doc;
+        }
+
+        // The page token of the list result.
+        TextView nextPageToken() const { return text(token_index); }
+
+        // The transaction Id of runQuery and batchGet results when the new transaction was started.
+        TextView transaction() const { return text(transaction_index); }
+
+    private:
+        JsonReader reader;
+        std::vector<DocumentView> docs;
+        int token_index = -1, transaction_index = -1;
+
+        // Add the document of runQuery and batchGet result element.
+        void addResult(uint32_t index)
+        {
+            if (reader.tape[index].type != json_value_type_object)
+                return;
+
+            if (transaction_index == -1)
+                transaction_index = member(index, "transaction");
+
+            DocumentView doc;
+
+            // The listen response e.g. {"documentChange":{"document":{...}}} or {"documentDelete":{"document":"<name>"}}.
+            int removed = member(index, "documentDelete");
+            if (removed == -1)
+                removed = member(index, "documentRemove");
+            if (removed > -1)
+            {
+                doc.elem_index = removed;
+                doc.name_index = member(removed, "document");
+                docs.push_back(doc);
+                return;
+            }
+            if (member(index, "documentChange") > -1)
+                index = member(index, "documentChange");
+
+            doc.elem_index = index;
+            doc.index = member(index, "document");
+            if (doc.index == -1)
+                doc.index = member(index, "found");
+            if (doc.index > -1)
+                doc.name_index = member(doc.index, "name");
+            else
+                doc.name_index = member(index, "missing");
+
+            // The result without document e.g. the readTime of empty query result.
+            if (doc.name_index > -1 || doc.index > -1)
+                docs.push_back(doc);
+        }
+
+        void addDocument(uint32_t index)
+        {
+            if (reader.tape[index].type != json_value_type_object)
+                return;
+            DocumentView doc;
+            doc.index = index;
+            doc.name_index = member(index, "name");
+            docs.push_back(doc);
+        }
+
+        int member(int obj, const char *key) const { return member(obj, key, strlen(key)); }
+
+        // Get the index of object member value.
+        int member(int obj, const char *key, size_t len) const
+        {
+            if (obj < 0 || reader.tape[obj].type != json_value_type_object)
+                return -1;
+
+            for (uint32_t i = obj + 1; i < reader.tape[obj].next; i = reader.tape[i + 1].next)
+            {
+                const JsonReader::token_t &k = reader.tape[i];
+                if (k.p2 - k.p1 == len && strncmp(reader.src + k.p1, key, len) == 0)
+                    return i + 1;
+            }
+            return -1;
+        }
+
+        // Get the index of the object member value or array element, the key index when key is true.
+        int child(int index, size_t n, bool key = false) const
+        {
+            if (index < 0 || (reader.tape[index].type != json_value_type_object && reader.tape[index].type != json_value_type_array))
+                return -1;
+
+            bool obj = reader.tape[index].type == json_value_type_object;
+            for (uint32_t i = index + 1; i < reader.tape[index].next; i = obj ? reader.tape[i + 1].next : reader.tape[i].next)
+            {
+                if (n-- == 0)
+                    return obj && !key ? i + 1 : i;
+            }
+            return -1;
+        }
+
+        size_t count(int index) const
+        {
+            size_t n = 0;
+            while (child(index, n) > -1)
+                n++;
+            return n;
+        }
+
+        uint8_t type(int index) const { return index > -1 ? reader.tape[index].type : (uint8_t)json_value_type_undefined; }
+
+        // The string characters without quotes or the number and literal characters.
+        TextView text(int index) const
+        {
+            if (index < 0 || reader.tape[index].type == json_value_type_object || reader.tape[index].type == json_value_type_array)
+                return TextView();
+            return TextView(reader.src + reader.tape[index].p1, reader.tape[index].p2 - reader.tape[index].p1);
+        }
+
+        TextView raw(int index) const
+        {
+            size_t len = 0;
+            const char *p = nullptr;
+            if (index > -1)
+            {
+                size_t q = reader.tape[index].type == json_value_type_string ? 1 : 0;
+                p = reader.src + reader.tape[index].p1 - q;
+                len = reader.tape[index].p2 - reader.tape[index].p1 + 2 * q;
+            }
+            return TextView(p, len);
+        }
+
+        /**
+         * Get the index of the typed value of the field in the fields object.
+         *
+         * The field path segments are separated by dot, the segment quoted with backticks can contain dot.
+         */
+        int field(int fields, const char *path) const
+        {
+            size_t i = 0, len = path ? strlen(path) : 0;
+            while (fields > -1 && i < len)
+            {
+                int value = -1;
+                if (path[i] == '`')
+                {
+                    // The quoted segment is unescaped to the stack buffer.
+                    char seg[128];
+                    size_t n = 0;
+                    for (i++; i < len && path[i] != '`'; i++)
+                    {
+                        if (path[i] == '\\' && i + 1 < len)
+                            i++;
+                        if (n < sizeof(seg))
+                            seg[n++] = path[i];
+                    }
+                    if (i++ >= len || n == sizeof(seg))
+                        return -1;
+                    value = member(fields, seg, n);
+                }
+                else
+                {
+                    size_t p1 = i;
+                    while (i < len && path[i] != '.')
+                        i++;
+                    value = member(fields, path + p1, i - p1);
+                }
+
+                if (value == -1 || i == len)
+                    return value;
+
+                if (path[i++] != '.')
+                    return -1;
+                fields = member(member(value, "mapValue"), "fields");
+            }
+            return -1;
+        }
+    };
+
+    inline firestore_const_key_type ValueView::type() const
+    {
+        int k = reader ? reader->child(index, 0, true) : -1;
+        if (k == -1)
+            return firestore_const_key_maxType;
+
+        TextView name = reader->text(k);
+        for (int i = 0; i < firestore_const_key_maxType; i++)
+        {
+            if (name.equals(firestore_const_key[i].text))
+                return (firestore_const_key_type)i;
+        }
+        return firestore_const_key_maxType;
+    }
+
+    inline int ValueView::typed(firestore_const_key_type t) const { return reader ? reader->member(index, firestore_const_key[t].text) : -1; }
+
+    inline bool ValueView::toBool() const { return reader && reader->text(typed(firestore_const_key_booleanValue)).equals("true"); }
+
+    inline int64_t ValueView::toInt() const
+    {
+        int v = typed(firestore_const_key_integerValue);
+        if (v > -1)
+            // The number string is terminated by its closing quote.
+            return strtoll(reader->text(v).data(), nullptr, 10);
+        return (int64_t)toDouble();
+    }
+
+    inline double ValueView::toDouble() const
+    {
+        int v = typed(firestore_const_key_doubleValue);
+        if (v == -1)
+            v = typed(firestore_const_key_integerValue);
+        // The number is followed by the delimiter and the string by its closing quote e.g. "NaN" and "-Infinity".
+        return v > -1 ? strtod(reader->text(v).data(), nullptr) : 0;
+    }
+
+    inline TextView ValueView::toText() const
+    {
+        firestore_const_key_type t = type();
+        if (t == firestore_const_key_stringValue || t == firestore_const_key_timestampValue || t == firestore_const_key_bytesValue || t == firestore_const_key_referenceValue)
+            return reader->text(reader->child(index, 0));
+        return TextView();
+    }
+
+    inline bool ValueView::toTimestamp(int64_t &seconds, uint32_t &nanos) const
+    {
+        seconds = 0;
+        nanos = 0;
+        TextView ts = reader ? reader->text(typed(firestore_const_key_timestampValue)) : TextView();
+        const char *s = ts.data();
+        size_t len = ts.length(), i = 0;
+
+        // YYYY-MM-DDTHH:MM:SS[.fraction](Z|+HH:MM|-HH:MM)
+        if (len < 20)
+            return false;
+
+        int v[6];
+        const uint8_t pos[6] = {0, 5, 8, 11, 14, 17}, width[6] = {4, 2, 2, 2, 2, 2};
+        for (int j = 0; j < 6; j++)
+        {
+            v[j] = 0;
+            for (i = pos[j]; i < (size_t)(pos[j] + width[j]); i++)
+            {
+                if (s[i] < '0' || s[i] > '9')
+                    return false;
+                v[j] = v[j] * 10 + s[i] - '0';
+            }
+        }
+
+        i = 19;
+        if (s[i] == '.')
+        {
+            uint32_t scale = 100000000;
+            for (i++; i < len && s[i] >= '0' && s[i] <= '9'; i++)
+            {
+                nanos += (s[i] - '0') * scale;
+                scale /= 10;
+            }
+        }
+
+        int32_t offset = 0;
+        if (i < len && (s[i] == '+' || s[i] == '-') && i + 5 < len)
+        {
+            offset = ((s[i + 1] - '0') * 10 + (s[i + 2] - '0')) * 3600 + ((s[i + 4] - '0') * 10 + (s[i + 5] - '0')) * 60;
+            if (s[i] == '-')
+                offset = -offset;
+        }
+        else if (i >= len || (s[i] != 'Z' && s[i] != 'z'))
+            return false;
+
+        // The days since epoch of the civil date.
+        int y = v[1] <= 2 ? v[0] - 1 : v[0];
+        int era = (y >= 0 ? y : y - 399) / 400;
+        int yoe = y - era * 400;
+        int doy = (153 * (v[1] + (v[1] > 2 ? -3 : 9)) + 2) / 5 + v[2] - 1;
+        int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        int64_t days = (int64_t)era * 146097 + doe - 719468;
+
+        seconds = days * 86400 + v[3] * 3600 + v[4] * 60 + v[5] - offset;
+        return true;
+    }
+
+    inline size_t ValueView::toBytes(uint8_t *buf, size_t size) const
+    {
+        TextView b64 = reader ? reader->text(typed(firestore_const_key_bytesValue)) : TextView();
+        const char *s = b64.data();
+        size_t len = b64.length();
+        while (len && s[len - 1] == '=')
+            len--;
+
+        size_t out_len = len * 3 / 4;
+        if (len == 0 || !buf)
+            return out_len;
+        if (size < out_len)
+            return 0;
+
+        uint32_t acc = 0;
+        int bits = 0;
+        size_t n = 0;
+        for (size_t i = 0; i < len; i++)
+        {
+            char c = s[i];
+            int d = c >= 'A' && c <= 'Z' ? c - 'A' : c >= 'a' && c <= 'z' ? c - 'a' + 26 : c >= '0' && c <= '9' ? c - '0' + 52 : c == '+' || c == '-' ? 62 : c == '/' || c == '_' ? 63 : -1;
+            if (d == -1)
+                return 0;
+            acc = (acc << 6) | d;
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                buf[n++] = (acc >> bits) & 0xFF;
+            }
+        }
+        return n;
+    }
+
+    inline double ValueView::latitude() const
+    {
+        int v = reader ? reader->member(typed(firestore_const_key_geoPointValue), "latitude") : -1;
+        return v > -1 ? strtod(reader->text(v).data(), nullptr) : 0;
+    }
+
+    inline double ValueView::longitude() const
+    {
+        int v = reader ? reader->member(typed(firestore_const_key_geoPointValue), "longitude") : -1;
+        return v > -1 ? strtod(reader->text(v).data(), nullptr) : 0;
+    }
+
+    inline size_t ValueView::size() const
+    {
+        if (!reader)
+            return 0;
+        int arr = reader->member(typed(firestore_const_key_arrayValue), "values");
+        return arr > -1 ? reader->count(arr) : reader->count(reader->member(typed(firestore_const_key_mapValue), "fields"));
+    }
+
+    inline ValueView ValueView::at(size_t i) const
+    {
+        if (!reader)
+            return ValueView();
+        int arr = reader->member(typed(firestore_const_key_arrayValue), "values");
+        return ValueView(reader, reader->child(arr > -1 ? arr : reader->member(typed(firestore_const_key_mapValue), "fields"), i));
+    }
+
+    inline TextView ValueView::key(size_t i) const
+    {
+        return reader ? reader->text(reader->child(reader->member(typed(firestore_const_key_mapValue), "fields"), i, true)) : TextView();
+    }
+
+    inline ValueView ValueView::get(const char *fieldPath) const
+    {
+        return reader ? ValueView(reader, reader->field(reader->member(typed(firestore_const_key_mapValue), "fields"), fieldPath)) : ValueView();
+    }
+
+    inline TextView ValueView::raw() const { return reader ? reader->raw(index) : TextView(); }
+
+    inline TextView DocumentView::name() const { return reader ? reader->text(name_index) : TextView(); }
+
+    inline TextView DocumentView::id() const
+    {
+        TextView n = name();
+        size_t i = n.length();
+        while (i > 0 && n.data()[i - 1] != '/')
+            i--;
+        return TextView(n.data() + i, n.length() - i);
+    }
+
+    inline TextView DocumentView::createTime() const { return reader ? reader->text(reader->member(index, "createTime")) : TextView(); }
+
+    inline TextView DocumentView::updateTime() const { return reader ? reader->text(reader->member(index, "updateTime")) : TextView(); }
+
+    inline TextView DocumentView::readTime() const { return reader ? reader->text(reader->member(elem_index, "readTime")) : TextView(); }
+
+    inline size_t DocumentView::size() const { return reader ? reader->count(reader->member(index, "fields")) : 0; }
+
+    inline TextView DocumentView::key(size_t i) const { return reader ? reader->text(reader->child(reader->member(index, "fields"), i, true)) : TextView(); }
+
+    inline ValueView DocumentView::at(size_t i) const { return reader ? ValueView(reader, reader->child(reader->member(index, "fields"), i)) : ValueView(); }
+
+    inline ValueView DocumentView::get(const char *fieldPath) const { return reader ? ValueView(reader, reader->field(reader->member(index, "fields"), fieldPath)) : ValueView(); }
+}
+
+#endif
+
+#endif
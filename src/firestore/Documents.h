@@ -29,6 +29,10 @@
 #include "./core/FirebaseApp.h"
 #include "./firestore/DataOptions.h"
 #include "./firestore/FirestoreBase.h"
+#include "./firestore/DocumentReader.h"
+#include "./firestore/DocumentIterator.h"
+#include "./firestore/DocumentListener.h"
+#include "./firestore/BatchWriter.h"
 
 #if defined(ENABLE_FIRESTORE)
 
@@ -43,6 +47,15 @@ namespace Firestore
         friend class AppBase;
 
     public:
+        ~Documents()
+        {
+            for (size_t i = 0; i < write_batches.size(); i++)
+            {
+                delete write_batches[i]->result;
+                delete write_batches[i];
+            }
+        }
+
         /** Gets multiple documents.
          *
          * @param aClient The async client.
@@ -214,6 +227,79 @@ namespace Firestore
             batchWriteDoc(aClient, nullptr, cb, uid, parent, writes, true);
         }
 
+        /** Add the write operation to the batch writer.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * @param write The Write object.
+         * @param aResult The async result (AsyncResult).
+         *
+         * The pending writes of the same async client and parent are sent in a single batchWrite request when
+         * the thresholds of Documents::setBatchWriter were reached, or from Documents::loop when its time window was reached.
+         *
+         * The status of the write is returned to the AsyncResult, the WriteResult object e.g. {"updateTime":"..."}
+         * is the payload when the write was applied, the status code (google.rpc.Code) and message are the error when the write failed.
+         *
+         * This function requires ServiceAuth authentication.
+         */
+        void write(AsyncClientClass &aClient, const Firestore::Parent &parent, const Write &write, AsyncResult &aResult)
+        {
+            addWrite(aClient, parent, write, &aResult, NULL, "");
+        }
+
+        /** Add the write operation to the batch writer.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * @param write The Write object.
+         * @param cb The async result callback (AsyncResultCallback).
+         * @param uid The user specified UID of async result (optional).
+         *
+         * The pending writes of the same async client and parent are sent in a single batchWrite request when
+         * the thresholds of Documents::setBatchWriter were reached, or from Documents::loop when its time window was reached.
+         *
+         * The status of the write is returned to the async result callback, the WriteResult object e.g. {"updateTime":"..."}
+         * is the payload when the write was applied, the status code (google.rpc.Code) and message are the error when the write failed.
+         *
+         * This function requires ServiceAuth authentication.
+         */
+        void write(AsyncClientClass &aClient, const Firestore::Parent &parent, const Write &write, AsyncResultCallback cb, const String &uid = "")
+        {
+            addWrite(aClient, parent, write, nullptr, cb, uid);
+        }
+
+        /**
+         * Set the thresholds of the batch writer for Documents::write.
+         *
+         * @param maxWrites The number of pending writes that are sent immediately (1 to 500).
+         * @param maxSize The payload size in bytes of pending writes that are sent immediately.
+         * @param window The maximum time in milliseconds that the writes are kept before they are sent.
+         * @param maxRetry The number of times that the write is sent again when it failed with the
+         * ABORTED, UNAVAILABLE, RESOURCE_EXHAUSTED, DEADLINE_EXCEEDED or INTERNAL status, or the request failed
+         * because of network or server error.
+         *
+         * Only the failed writes are sent again with the next batch, the writes of batchWrite request are not applied in order.
+         */
+        void setBatchWriter(uint16_t maxWrites, size_t maxSize = 16384, uint32_t window = 1000, uint8_t maxRetry = 3)
+        {
+            batch_max_writes = maxWrites == 0 ? 1 : (maxWrites > 500 ? 500 : maxWrites);
+            batch_max_size = maxSize;
+            batch_window = window;
+            batch_max_retry = maxRetry;
+        }
+
+        /**
+         * Send the pending writes of the batch writer.
+         */
+        void flushWrites()
+        {
+            for (size_t i = 0; i < write_batches.size(); i++)
+            {
+                if (!write_batches[i]->result)
+                    sendWriteBatch(write_batches[i]);
+            }
+        }
+
         /** Starts a new transaction.
          *
          * @param aClient The async client.
@@ -824,6 +910,63 @@ namespace Firestore
             listCollIds(aClient, nullptr, cb, uid, parent, documentPath, listCollectionIdsOptions, true);
         }
 
+        /** Iterate the documents in the defined documents collection in pages.
+         *
+         * ### Example
+         * ```cpp
+         * DocumentIterator iterator(100);
+         *
+         * Docs.iterate(aClient, Firestore::Parent("my-project"), "users", ListDocumentsOptions(), iterator);
+         *
+         * // In loop
+         * Docs.loop();
+         * while (iterator.next())
+         *     Serial.println(iterator.document().id());
+         * ```
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * The Firebase project Id should be only the name without the firebaseio.com.
+         * The Firestore database id should be (default) or empty "".
+         * @param collectionId The relative path of document colection.
+         * @param listDocsOptions The ListDocumentsOptions object e.g. orderBy, mask and showMissing options,
+         * the pageSize and pageToken options are set by the iterator.
+         * @param iterator The DocumentIterator object to iterate the documents.
+         *
+         * The next page is requested with the nextPageToken of the previous page from Documents::loop while the current page is iterated.
+         *
+         * This function requires ServiceAuth, CustomAuth, UserAuth, CustomToken or IDToken authentication.
+         *
+         */
+        void iterate(AsyncClientClass &aClient, const Firestore::Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, DocumentIterator &iterator)
+        {
+            iterator.reset();
+            iterator.list_options = listDocsOptions;
+            startIterator(aClient, parent, collectionId, DocumentIterator::iterator_type_list, iterator);
+        }
+
+        /** Iterate the document collection ids in the defined document path in pages.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * The Firebase project Id should be only the name without the firebaseio.com.
+         * The Firestore database id should be (default) or empty "".
+         * @param documentPath The relative path of document to get its collections' id.
+         * @param listCollectionIdsOptions The ListCollectionIdsOptions object e.g. readTime option,
+         * the pageSize and pageToken options are set by the iterator.
+         * @param iterator The DocumentIterator object to iterate the collection ids.
+         *
+         * The next page is requested with the nextPageToken of the previous page from Documents::loop while the current page is iterated.
+         *
+         * This function requires ServiceAuth authentication.
+         *
+         */
+        void iterateCollectionIds(AsyncClientClass &aClient, const Firestore::Parent &parent, const String &documentPath, const ListCollectionIdsOptions &listCollectionIdsOptions, DocumentIterator &iterator)
+        {
+            iterator.reset();
+            iterator.ids_options = listCollectionIdsOptions;
+            startIterator(aClient, parent, documentPath, DocumentIterator::iterator_type_collection_ids, iterator);
+        }
+
         /** Patch or update a document at the defined path.
          *
          * @param aClient The async client.
@@ -1082,9 +1225,443 @@ namespace Firestore
             runQueryImpl(aClient, nullptr, cb, uid, parent, documentPath, queryOptions, true);
         }
 
+        /** Iterate the query results in pages.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * The Firebase project Id should be only the name without the firebaseio.com.
+         * The Firestore database id should be (default) or empty "".
+         * @param documentPath The relative path of the parent document of the query.
+         * @param query The StructuredQuery object, its limit and offset are applied to all pages.
+         * @param iterator The DocumentIterator object to iterate the documents.
+         *
+         * The documents are ordered by the query orderBy fields and then __name__, the next page is requested
+         * with the startAt cursor of the order field values of the last document of previous page from Documents::loop
+         * while the current page is iterated.
+         *
+         * The query with inequality filters should order by the inequality fields.
+         *
+         * This function requires ServiceAuth, CustomAuth, UserAuth, CustomToken or IDToken authentication.
+         *
+         */
+        void iterateQuery(AsyncClientClass &aClient, const Firestore::Parent &parent, const String &documentPath, const StructuredQuery &query, DocumentIterator &iterator)
+        {
+            iterator.reset();
+            iterator.setQuery(query);
+            startIterator(aClient, parent, documentPath, DocumentIterator::iterator_type_query, iterator);
+        }
+
 #endif
 
+        /** Set the results of the following async runQuery and batchGet requests to be streamed.
+         *
+         * @param enable Set to true to return each element of the response array e.g. {"document":{...},"readTime":"..."}
+         * as soon as it was read, the memory usage is bounded by the largest element instead of the whole response.
+         *
+         * The result of each element is returned via the AsyncResult or async result callback, the last result without
+         * payload is returned when the response was completely read. The async result callback should be used
+         * because the element that was not taken from AsyncResult will be replaced by the next element.
+         *
+         * The error response and the sync requests are not streamed.
+         */
+        void setStreamResults(bool enable) { stream_results = enable; }
+
+        /** Listen to the changes of documents or query.
+         *
+         * ### Example
+         *
+         * ```cpp
+         * DocumentListener listener;
+         * listener.addDocument("users/alice");
+         *
+         * Docs.listen(aClient, Firestore::Parent("my-project"), listener, asyncCB, "listenTask");
+         *
+         * // In loop
+         * Docs.loop();
+         * ```
+         *
+         * @param aClient The async client. The dedicated async client should be used because the request is kept open.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * @param listener The DocumentListener object that keeps the listen target and its resume token.
+         * @param cb The async result callback (AsyncResultCallback).
+         * @param uid The user specified UID of async result (optional).
+         *
+         * The ListenResponse object e.g. {"documentChange":{...}} or {"targetChange":{...}} is returned via the async result callback.
+         * The payload can be read with DocumentReader.
+         *
+         * The session and back channel requests are sent again from Documents::loop when they were closed or failed,
+         * the target is added again with the last resume token.
+         *
+         * This function requires ENABLE_FIRESTORE build flag.
+         */
+        void listen(AsyncClientClass &aClient, const Firestore::Parent &parent, DocumentListener &listener, AsyncResultCallback cb, const String &uid = "")
+        {
+            listener.stop();
+            listener.client = &aClient;
+            listener.parent = parent;
+            listener.cb = cb;
+            listener.uid = uid.length() ? uid : String(FPSTR("listen_")) + String(reinterpret_cast<uint32_t>(&listener));
+            listener.owner = reinterpret_cast<uint32_t>(this);
+            listener.clearSession();
+            listener.aid = 0;
+            listener.retry_delay = 0;
+            listener.stopped = false;
+
+            // The listener is removed from this list when it was stopped or destroyed.
+            List vec;
+            vec.addRemoveList(DocumentListener::list(), reinterpret_cast<uint32_t>(&listener), true);
+            processListener(&listener);
+        }
+
+        /**
+         * Perform the async task repeatedly, request the next pages of iterators, keep the listen channels open
+         * and send the pending writes of the batch writer.
+         * Should be placed in main loop function.
+         */
+        void loop()
+        {
+            FirestoreBase::loop();
+            processIterators();
+            processListeners();
+            processWriteBatches();
+        }
+
     private:
+        std::vector<uint32_t> iterators; // DocumentIterator vector
+        uint16_t batch_max_writes = 500;
+        size_t batch_max_size = 16384;
+        uint32_t batch_window = 1000;
+        uint8_t batch_max_retry = 3;
+
+        // The pending writes of async client and parent, the result is created when the batchWrite request was sent.
+        struct write_batch_t
+        {
+            AsyncClientClass *client = nullptr;
+            Firestore::Parent parent;
+            BatchWriter writer;
+            AsyncResult *result = nullptr;
+            uint32_t slot_addr = 0;
+        };
+        std::vector<write_batch_t *> write_batches;
+
+        void addWrite(AsyncClientClass &aClient, const Firestore::Parent &parent, const Write &write, AsyncResult *aResult, AsyncResultCallback cb, const String &uid)
+        {
+            BatchWriter::item_t item;
+            item.write = write.c_str();
+            item.uid = uid;
+            item.aResult = aResult;
+            item.cb = cb;
+
+            if (aResult)
+            {
+                // The async result is removed from this list when it was destroyed.
+                List vec;
+                vec.addRemoveList(getRVec(&aClient), reinterpret_cast<uint32_t>(aResult), true);
+                setRVec(aResult, reinterpret_cast<uint32_t>(&getRVec(&aClient)));
+            }
+
+            write_batch_t *batch = pendingBatch(aClient, parent);
+            batch->writer.add(item);
+            if (batch->writer.size() >= batch_max_writes || batch->writer.length() >= batch_max_size)
+                sendWriteBatch(batch);
+        }
+
+        // Get the batch of async client and parent that was not sent.
+        write_batch_t *pendingBatch(AsyncClientClass &aClient, const Firestore::Parent &parent)
+        {
+            for (size_t i = 0; i < write_batches.size(); i++)
+            {
+                write_batch_t *batch = write_batches[i];
+                if (batch->client == &aClient && !batch->result && batch->parent.getProjectId() == parent.getProjectId() && batch->parent.getDatabaseId() == parent.getDatabaseId())
+                    return batch;
+            }
+
+            write_batch_t *batch = new write_batch_t();
+            batch->client = &aClient;
+            batch->parent = parent;
+            write_batches.push_back(batch);
+            return batch;
+        }
+
+        void sendWriteBatch(write_batch_t *batch)
+        {
+            String payload;
+            batch->writer.getPayload(payload);
+            batch->result = new AsyncResult();
+            batch->slot_addr = batchWriteImpl(*batch->client, batch->result, NULL, "", batch->parent, payload, true);
+        }
+
+        // Send the pending writes when the time window was reached and return the results of completed batchWrite requests.
+        void processWriteBatches()
+        {
+            size_t i = 0;
+            while (i < write_batches.size())
+            {
+                write_batch_t *batch = write_batches[i];
+
+                if (!batch->result)
+                {
+                    if (batch->writer.elapsed() >= batch_window || batch->writer.size() >= batch_max_writes || batch->writer.length() >= batch_max_size)
+                        sendWriteBatch(batch);
+                    i++;
+                    continue;
+                }
+
+                if (slotExistedBase(batch->client, batch->slot_addr))
+                {
+                    i++;
+                    continue;
+                }
+
+                write_batches.erase(write_batches.begin() + i);
+                resolveWriteBatch(batch);
+                delete batch->result;
+                delete batch;
+            }
+        }
+
+        void resolveWriteBatch(write_batch_t *batch)
+        {
+            AsyncResult *result = batch->result;
+            bool error = result->isError();
+            int code = error ? result->error().code() : 0;
+            String message = error ? result->error().message() : String();
+
+            // The whole request can be sent again when it failed because of network or server error.
+            bool retry_request = error && (code < 0 || code == 429 || code == 500 || code == 502 || code == 503 || code == 504);
+
+            String response = result->c_str();
+            JsonReader reader;
+            if (!error)
+                reader.parse(response);
+
+            for (size_t i = 0; i < batch->writer.items.size(); i++)
+            {
+                BatchWriter::item_t &item = batch->writer.items[i];
+                int status = code;
+                String msg = message;
+                if (!error)
+                    status = BatchWriter::status(reader, i, msg);
+
+                // Only the failed writes are added to the next batch.
+                if (status != 0 && item.attempts < batch_max_retry && (error ? retry_request : BatchWriter::retryable(status)))
+                {
+                    item.attempts++;
+                    pendingBatch(*batch->client, batch->parent)->writer.add(item);
+                    continue;
+                }
+
+                resolveWrite(batch, item, status, msg, error ? String() : reader.get("/writeResults/" + String(i)));
+            }
+        }
+
+        void resolveWrite(write_batch_t *batch, const BatchWriter::item_t &item, int code, const String &message, const String &payload)
+        {
+            AsyncResult res;
+            AsyncResult *aResult = &res;
+
+            List vec;
+            if (item.aResult && vec.existed(getRVec(batch->client), reinterpret_cast<uint32_t>(item.aResult)))
+                aResult = item.aResult;
+            else if (!item.cb)
+                return;
+
+            clearLastErrorBase(aResult);
+            if (item.uid.length())
+                setResultUID(aResult, item.uid);
+
+            if (code)
+                setLastErrorBase(aResult, code, message);
+            else
+                setResultPayload(aResult, payload.length() ? payload : String(FPSTR("{}")));
+
+            if (item.cb)
+                item.cb(*aResult);
+        }
+
+        void processListeners()
+        {
+            std::vector<uint32_t> &listeners = DocumentListener::list();
+            size_t i = 0;
+            while (i < listeners.size())
+            {
+                DocumentListener *listener = reinterpret_cast<DocumentListener *>(listeners[i]);
+                if (listener->owner == reinterpret_cast<uint32_t>(this))
+                {
+                    if (listener->stopped)
+                    {
+                        listeners.erase(listeners.begin() + i);
+                        continue;
+                    }
+                    processListener(listener);
+                }
+                i++;
+            }
+        }
+
+        // Create the session (handshake) or open the back channel when the previous request was completed.
+        void processListener(DocumentListener *listener)
+        {
+            if (listener->slot_addr)
+            {
+                if (slotExistedBase(listener->client, listener->slot_addr))
+                    return;
+
+                listener->slot_addr = 0;
+
+                // The session was not created or nothing was received from the back channel,
+                // the new session will be created after the retry delay.
+                if (listener->handshake ? listener->sid.length() == 0 : listener->received == 0)
+                {
+                    listener->clearSession();
+                    listener->setRetry();
+                }
+            }
+
+            if (listener->stopped || millis() - listener->retry_ms < listener->retry_delay)
+                return;
+
+            String database = makeDatabasePath(listener->parent);
+            listener->received = 0;
+            listener->handshake = listener->sid.length() == 0;
+            if (listener->handshake)
+            {
+                listener->aid = 0;
+                listener->rid++;
+                listener->slot_addr = listenChannel(*listener->client, listenCallback, listener->uid, listener->parent, listener->params(database, false), listener->payload(database));
+            }
+            else
+                listener->slot_addr = listenChannel(*listener->client, listenCallback, listener->uid, listener->parent, listener->params(database, true), "");
+
+            if (!listener->slot_addr)
+                listener->setRetry();
+        }
+
+        // Dispatch the WebChannel messages to the listener, the ListenResponse objects are returned via the listener callback.
+        static void listenCallback(AsyncResult &aResult)
+        {
+            std::vector<uint32_t> &listeners = DocumentListener::list();
+            DocumentListener *listener = nullptr;
+            for (size_t i = 0; i < listeners.size(); i++)
+            {
+                DocumentListener *l = reinterpret_cast<DocumentListener *>(listeners[i]);
+                if (!l->stopped && l->uid == aResult.uid())
+                    listener = l;
+            }
+
+            if (!listener)
+                return;
+
+            // The session id is sent with the following requests of this session.
+            Documents *owner = reinterpret_cast<Documents *>(listener->owner);
+            if (listener->handshake && owner->getResultSessionId(&aResult).length())
+                listener->gsessionid = owner->getResultSessionId(&aResult);
+
+            // The payload of each element is cleared after it was returned.
+            if (aResult.c_str()[0] == '[')
+            {
+                String response;
+                if (listener->parseMessage(aResult.c_str(), response))
+                {
+                    owner->setResultPayload(&aResult, response);
+                    if (listener->cb)
+                        listener->cb(aResult);
+                }
+                return;
+            }
+
+            if (listener->cb)
+                listener->cb(aResult);
+        }
+
+        void startIterator(AsyncClientClass &aClient, const Firestore::Parent &parent, const String &path, DocumentIterator::iterator_type type, DocumentIterator &iterator)
+        {
+            iterator.client = &aClient;
+            iterator.parent = parent;
+            iterator.path = path;
+            iterator.type = type;
+
+            // The iterator is removed from this list when it was destroyed.
+            List vec;
+            vec.addRemoveList(iterators, reinterpret_cast<uint32_t>(&iterator), true);
+            iterator.ivec_addr = reinterpret_cast<uint32_t>(&iterators);
+            processIterator(&iterator);
+        }
+
+        void processIterators()
+        {
+            size_t i = 0;
+            while (i < iterators.size())
+            {
+                DocumentIterator *iterator = reinterpret_cast<DocumentIterator *>(iterators[i]);
+                processIterator(iterator);
+
+                // All pages were received or the iteration was stopped.
+                if ((iterator->last_page || iterator->stopped) && !iterator->pending())
+                {
+                    iterator->ivec_addr = 0;
+                    iterators.erase(iterators.begin() + i);
+                }
+                else
+                    i++;
+            }
+        }
+
+        // Keep the received page and request the next page when the next page was taken.
+        void processIterator(DocumentIterator *iterator)
+        {
+            if (iterator->result)
+            {
+                if (slotExistedBase(iterator->client, iterator->slot_addr))
+                    return;
+
+                // The page that was received after the iteration was stopped is ignored.
+                if (!iterator->stopped)
+                {
+                    if (iterator->result->isError())
+                    {
+                        iterator->err = iterator->result->error();
+                        iterator->last_page = true;
+                    }
+                    else
+                        iterator->setNextPage(iterator->result->c_str());
+                }
+
+                delete iterator->result;
+                iterator->result = nullptr;
+                iterator->slot_addr = 0;
+            }
+
+            if (iterator->last_page || iterator->next_ready || iterator->stopped)
+                return;
+
+            iterator->result = new AsyncResult();
+            if (iterator->type == DocumentIterator::iterator_type_list)
+            {
+                iterator->setListPage();
+                iterator->slot_addr = listDocs(*iterator->client, iterator->result, NULL, "", iterator->parent, iterator->path, iterator->list_options, true);
+            }
+            else if (iterator->type == DocumentIterator::iterator_type_collection_ids)
+            {
+                iterator->setListPage();
+                iterator->slot_addr = listCollIds(*iterator->client, iterator->result, NULL, "", iterator->parent, iterator->path, iterator->ids_options, true);
+            }
+#if defined(ENABLE_FIRESTORE_QUERY)
+            else
+            {
+                StructuredQuery query;
+                iterator->setQueryPage(query);
+                QueryOptions queryOptions;
+                queryOptions.structuredQuery(query);
+
+                // The page is read as a whole response.
+                bool stream = stream_results;
+                stream_results = false;
+                iterator->slot_addr = runQueryImpl(*iterator->client, iterator->result, NULL, "", iterator->parent, iterator->path, queryOptions, true);
+                stream_results = stream;
+            }
+#endif
+        }
     };
 
 }
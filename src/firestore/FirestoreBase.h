@@ -92,6 +92,7 @@ protected:
     uint32_t app_addr = 0, avec_addr = 0;
     uint32_t ul_dl_task_running_addr = 0;
     app_token_t *app_token = nullptr;
+    bool stream_results = false;
 
     struct async_request_data_t
     {
@@ -104,6 +105,10 @@ protected:
         Firestore::DataOptions *options = nullptr;
         AsyncResult *aResult = nullptr;
         AsyncResultCallback cb = NULL;
+        // The elements of runQuery and batchGet results are returned one by one.
+        bool array_stream = false;
+        // The address of the slot that was created.
+        uint32_t slot_addr = 0;
         async_request_data_t() {}
         explicit async_request_data_t(AsyncClientClass *aClient, const String &path, async_request_handler_t::http_request_method method, slot_options_t opt, Firestore::DataOptions *options, AsyncResult *aResult, AsyncResultCallback cb, const String &uid = "")
         {
@@ -152,18 +157,24 @@ protected:
 
         request.opt.app_token = atoken;
         String extras;
-        if (beta == 2)
-            uut.addGAPIv1beta2Path(request.path);
-        else if (beta == 1)
-            uut.addGAPIv1beta1Path(request.path);
+        bool listen = request.options->requestType == firebase_firestore_request_type_listen;
+        if (listen)
+            request.path = FPSTR("/google.firestore.v1.Firestore/Listen/channel");
         else
-            uut.addGAPIv1Path(request.path);
-        request.path += request.options->parent.getProjectId().length() == 0 ? atoken->val[app_tk_ns::pid] : request.options->parent.getProjectId();
-        request.path += FPSTR("/databases");
-        if (!request.options->parent.isDatabaseIdParam())
         {
-            request.path += '/';
-            request.path += request.options->parent.getDatabaseId().length() > 0 ? request.options->parent.getDatabaseId() : FPSTR("(default)");
+            if (beta == 2)
+                uut.addGAPIv1beta2Path(request.path);
+            else if (beta == 1)
+                uut.addGAPIv1beta1Path(request.path);
+            else
+                uut.addGAPIv1Path(request.path);
+            request.path += request.options->parent.getProjectId().length() == 0 ? atoken->val[app_tk_ns::pid] : request.options->parent.getProjectId();
+            request.path += FPSTR("/databases");
+            if (!request.options->parent.isDatabaseIdParam())
+            {
+                request.path += '/';
+                request.path += request.options->parent.getDatabaseId().length() > 0 ? request.options->parent.getDatabaseId() : FPSTR("(default)");
+            }
         }
         addParams(request, extras);
 
@@ -179,12 +190,19 @@ protected:
         if (request.options->payload.length())
         {
             sData->request.val[req_hndlr_ns::payload] = request.options->payload;
+            // The WebChannel request body is the form data.
+            if (listen)
+                setContentTypeBase(request.aClient, sData, FPSTR("application/x-www-form-urlencoded"));
             setContentLengthBase(request.aClient, sData, request.options->payload.length());
         }
 
         if (request.cb)
             sData->cb = request.cb;
 
+        sData->array_stream = request.array_stream && request.opt.async;
+        sData->response.array_parser.setFramed(listen);
+        request.slot_addr = sData->addr;
+
         addRemoveClientVecBase(request.aClient, reinterpret_cast<uint32_t>(&(cVec)), true);
 
         if (request.aResult)
@@ -326,16 +344,22 @@ protected:
     }
 
     void batchWriteDoc(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const Writes &writes, bool async)
+    {
+        batchWriteImpl(aClient, result, cb, uid, parent, writes.c_str(), async);
+    }
+
+    uint32_t batchWriteImpl(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &payload, bool async)
     {
         Firestore::DataOptions options;
         options.requestType = firebase_firestore_request_type_batch_write_doc;
         options.parent = parent;
-        options.payload = writes.c_str();
+        options.payload = payload;
         options.payload.replace(reinterpret_cast<const char *>(RESOURCE_PATH_BASE), makeResourcePath(parent));
         addDocsPath(options.extras);
         options.extras += FPSTR(":batchWrite");
         async_request_data_t aReq(&aClient, path, async_request_handler_t::http_post, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
         asyncRequest(aReq);
+        return aReq.slot_addr;
     }
 
     void getDoc(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &documentPath, GetDocumentOptions getOptions, bool async)
@@ -361,6 +385,7 @@ protected:
         addDocsPath(options.extras);
         options.extras += FPSTR(":batchGet");
         async_request_data_t aReq(&aClient, path, async_request_handler_t::http_post, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
+        aReq.array_stream = stream_results;
         asyncRequest(aReq);
     }
 
@@ -391,7 +416,7 @@ protected:
     }
 
 #if defined(ENABLE_FIRESTORE_QUERY)
-    void runQueryImpl(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &documentPath, const QueryOptions &queryOptions, bool async)
+    uint32_t runQueryImpl(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &documentPath, const QueryOptions &queryOptions, bool async)
     {
         Firestore::DataOptions options;
         options.requestType = firebase_firestore_request_type_run_query;
@@ -404,7 +429,9 @@ protected:
         uut.addPath(options.extras, documentPath);
         options.extras += FPSTR(":runQuery");
         async_request_data_t aReq(&aClient, path, async_request_handler_t::http_post, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
+        aReq.array_stream = stream_results;
         asyncRequest(aReq);
+        return aReq.slot_addr;
     }
 #endif
 
@@ -423,7 +450,7 @@ protected:
         asyncRequest(aReq);
     }
 
-    void listDocs(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, bool async)
+    uint32_t listDocs(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, bool async)
     {
         Firestore::DataOptions options;
         options.requestType = firebase_firestore_request_type_list_doc;
@@ -436,9 +463,10 @@ protected:
         options.extras += listDocsOptions.c_str();
         async_request_data_t aReq(&aClient, path, async_request_handler_t::http_get, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
         asyncRequest(aReq);
+        return aReq.slot_addr;
     }
 
-    void listCollIds(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &documentPath, const ListCollectionIdsOptions &listCollectionIdsOptions, bool async)
+    uint32_t listCollIds(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &documentPath, const ListCollectionIdsOptions &listCollectionIdsOptions, bool async)
     {
         Firestore::DataOptions options;
         options.requestType = firebase_firestore_request_type_list_collection;
@@ -453,6 +481,23 @@ protected:
 
         async_request_data_t aReq(&aClient, path, async_request_handler_t::http_post, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
         asyncRequest(aReq);
+        return aReq.slot_addr;
+    }
+
+    // Send the request of Firestore Listen WebChannel, the POST request when payload is set or the GET request (back channel).
+    uint32_t listenChannel(AsyncClientClass &aClient, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const String &params, const String &payload)
+    {
+        Firestore::DataOptions options;
+        options.requestType = firebase_firestore_request_type_listen;
+        options.parent = parent;
+        options.payload = payload;
+        options.extras = params;
+
+        async_request_handler_t::http_request_method method = payload.length() ? async_request_handler_t::http_post : async_request_handler_t::http_get;
+        async_request_data_t aReq(&aClient, path, method, slot_options_t(false, false, true, false, false, false), &options, nullptr, cb, uid);
+        aReq.array_stream = true;
+        asyncRequest(aReq);
+        return aReq.slot_addr;
     }
 
     void databaseIndexManager(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Firestore::Parent &parent, const DatabaseIndex::Index &index, const String &indexId, bool deleteMode, bool async)
@@ -520,6 +565,18 @@ protected:
         addDocsPath(str);
         return str;
     }
+
+    // The database resource name e.g. projects/{project_id}/databases/{database_id}.
+    String makeDatabasePath(const Firestore::Parent &parent)
+    {
+        app_token_t *atoken = appToken();
+        String str = FPSTR("projects/");
+        str += parent.getProjectId().length() == 0 && atoken ? atoken->val[app_tk_ns::pid] : parent.getProjectId();
+        addDatabasePath(str);
+        str += '/';
+        str += parent.getDatabaseId().length() > 0 ? parent.getDatabaseId() : FPSTR("(default)");
+        return str;
+    }
     void addDatabasePath(String &buf) { buf += FPSTR("/databases"); }
     void addDocsPath(String &buf) { buf += FPSTR("/documents"); }
 };
@@ -65,7 +65,7 @@ namespace FirestoreQuery
     Order &Order::field(const FieldReference &value) { return wr.set<Order &, FieldReference>(*this, value, buf, bufSize, 1, FPSTR(__func__)); }
     Order &Order::direction(FilterSort::Direction value) { return wr.set<Order &, const char *>(*this, FilterSort::_Direction[value].text, buf, bufSize, 2, FPSTR(__func__)); }
 
-    Cursor::Cursor() { wr.set<Cursor &, const char *>(*this, "[]", buf, bufSize, 2, "values"); }
+    Cursor::Cursor() {}
     Cursor &Cursor::before(bool value) { return wr.set<Cursor &, bool>(*this, value, buf, bufSize, 1, FPSTR(__func__)); }
     Cursor &Cursor::values(const Values::Value &value) { return wr.append<Cursor &, Values::Value>(*this, value, buf, bufSize, 2, FPSTR(__func__)); }
     Cursor &Cursor::addValue(const Values::Value &value) { return values(value); }